@@ -0,0 +1,114 @@
+#ifndef AABB_H
+#define AABB_H
+#include "engine/Rectangle.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace Engine {
+    // Axis-aligned bounding box stored as min/max corners (what broadphases work in)
+    struct AABB {
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = 0.0f;
+        float maxY = 0.0f;
+
+        AABB() = default;
+        AABB(float minX, float minY, float maxX, float maxY)
+            : minX(minX), minY(minY), maxX(maxX), maxY(maxY) {}
+
+        static AABB FromRectangle(const Rectangle<float>& rectangle) {
+            Vector2f position = rectangle.GetPosition();
+            Vector2f size = rectangle.GetSize();
+            float x2 = position.GetX() + size.GetX();
+            float y2 = position.GetY() + size.GetY();
+            return AABB(std::min(position.GetX(), x2), std::min(position.GetY(), y2),
+                        std::max(position.GetX(), x2), std::max(position.GetY(), y2));
+        }
+
+        // Inclusive test - touching boxes count, so it never rejects a pair that
+        // CollisionRectangle::IsColliding (strict) would accept
+        bool Overlaps(const AABB& other) const {
+            return minX <= other.maxX && maxX >= other.minX &&
+                   minY <= other.maxY && maxY >= other.minY;
+        }
+
+        bool Contains(const AABB& other) const {
+            return minX <= other.minX && minY <= other.minY &&
+                   maxX >= other.maxX && maxY >= other.maxY;
+        }
+
+        bool Contains(float x, float y) const {
+            return x >= minX && x <= maxX && y >= minY && y <= maxY;
+        }
+
+        // Move this box by (dx, dy) and find when it first touches other: time is the fraction
+        // of the move (0-1) and the normal is the axis of the face hit, pointing back at this
+        // box. Sliding flush along a face isn't a hit. A box already overlapping other hits at
+        // time 0 with a zero normal.
+        bool Sweep(const AABB& other, float dx, float dy, float& time, float& normalX, float& normalY) const {
+            normalX = 0.0f;
+            normalY = 0.0f;
+            if (minX < other.maxX && maxX > other.minX && minY < other.maxY && maxY > other.minY) {
+                time = 0.0f;
+                return true;
+            }
+
+            float entryX, exitX, entryY, exitY;
+            if (!SweepAxis(minX, maxX, other.minX, other.maxX, dx, entryX, exitX)) return false;
+            if (!SweepAxis(minY, maxY, other.minY, other.maxY, dy, entryY, exitY)) return false;
+            float entry = std::max(entryX, entryY);
+            float exit = std::min(exitX, exitY);
+            if (entry >= exit || entry < 0.0f || entry > 1.0f) return false;
+
+            time = entry;
+            if (entryX > entryY) {
+                normalX = dx > 0.0f ? -1.0f : 1.0f;
+            } else {
+                normalY = dy > 0.0f ? -1.0f : 1.0f;
+            }
+            return true;
+        }
+
+        // Smallest box holding both
+        static AABB Union(const AABB& a, const AABB& b) {
+            return AABB(std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+                        std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY));
+        }
+
+        // Grown by margin on every side
+        AABB Expanded(float margin) const {
+            return AABB(minX - margin, minY - margin, maxX + margin, maxY + margin);
+        }
+
+        // Cost metric for tree building (perimeter is the 2D surface area heuristic)
+        float GetPerimeter() const { return 2.0f * ((maxX - minX) + (maxY - minY)); }
+
+        float GetWidth() const { return maxX - minX; }
+        float GetHeight() const { return maxY - minY; }
+
+        bool operator==(const AABB& rhs) const {
+            return minX == rhs.minX && minY == rhs.minY && maxX == rhs.maxX && maxY == rhs.maxY;
+        }
+        bool operator!=(const AABB& rhs) const { return !(*this == rhs); }
+
+    private:
+        // Times (as a fraction of d) the interval [min, max] starts and stops overlapping
+        // [otherMin, otherMax] on one axis. False if it never does.
+        static bool SweepAxis(float min, float max, float otherMin, float otherMax, float d, float& entry, float& exit) {
+            if (d == 0.0f) {
+                entry = -std::numeric_limits<float>::infinity();
+                exit = std::numeric_limits<float>::infinity();
+                return min < otherMax && max > otherMin;
+            }
+            if (d > 0.0f) {
+                entry = (otherMin - max) / d;
+                exit = (otherMax - min) / d;
+            } else {
+                entry = (otherMax - min) / d;
+                exit = (otherMin - max) / d;
+            }
+            return true;
+        }
+    };
+}
+#endif
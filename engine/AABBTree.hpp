@@ -0,0 +1,277 @@
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+#include "engine/AABB.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Dynamic bounding volume hierarchy. Leaves hold a fattened copy of each entry's box,
+    // so small moves don't touch the tree at all; when an entry escapes its fat box the leaf
+    // is re-inserted and the path to the root is refit and rebalanced with rotations.
+    // Copes with wildly mixed sizes, unlike a uniform grid.
+    class AABBTree {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+    private:
+        struct Node {
+            AABB bounds;               // Fat box for leaves, union of children otherwise
+            uint32_t userData = 0;
+            int32_t parent = NullNode; // Doubles as the free-list link
+            int32_t child1 = NullNode;
+            int32_t child2 = NullNode;
+            int32_t height = 0;        // Leaf = 0, free = -1
+
+            bool IsLeaf() const { return child1 == NullNode; }
+        };
+
+        std::vector<Node> m_nodes;
+        int32_t m_root = NullNode;
+        int32_t m_freeList = NullNode;
+        size_t m_leafCount = 0;
+        float m_margin;
+
+    public:
+        // margin: how far an entry can move before its leaf has to be re-inserted
+        explicit AABBTree(float margin = 4.0f) : m_margin(margin) {}
+
+        void SetMargin(float margin) { m_margin = margin; }
+        float GetMargin() const { return m_margin; }
+
+        // Add an entry, returns its node id
+        int32_t Insert(const AABB& bounds, uint32_t userData) {
+            int32_t leaf = AllocateNode();
+            m_nodes[leaf].bounds = bounds.Expanded(m_margin);
+            m_nodes[leaf].userData = userData;
+            m_nodes[leaf].height = 0;
+            InsertLeaf(leaf);
+            m_leafCount++;
+            return leaf;
+        }
+
+        void Remove(int32_t leaf) {
+            RemoveLeaf(leaf);
+            FreeNode(leaf);
+            m_leafCount--;
+        }
+
+        // Update an entry's box. Returns true if the leaf had to be re-inserted,
+        // false if the new box still fits in the fat one.
+        bool Move(int32_t leaf, const AABB& bounds) {
+            if (m_nodes[leaf].bounds.Contains(bounds)) {
+                return false;
+            }
+            RemoveLeaf(leaf);
+            m_nodes[leaf].bounds = bounds.Expanded(m_margin);
+            InsertLeaf(leaf);
+            return true;
+        }
+
+        const AABB& GetFatBounds(int32_t leaf) const { return m_nodes[leaf].bounds; }
+        uint32_t GetUserData(int32_t leaf) const { return m_nodes[leaf].userData; }
+
+        // Call fn(userData) for every entry whose fat box overlaps bounds
+        template<typename Fn>
+        void Query(const AABB& bounds, Fn&& fn) const {
+            if (m_root == NullNode) return;
+
+            // Borrow this thread's stack (a nested query from fn gets a fresh one)
+            std::vector<int32_t> stack;
+            stack.swap(StackBuffer());
+            stack.push_back(m_root);
+            while (!stack.empty()) {
+                const Node& node = m_nodes[stack.back()];
+                stack.pop_back();
+                if (!node.bounds.Overlaps(bounds)) continue;
+                if (node.IsLeaf()) {
+                    fn(node.userData);
+                } else {
+                    stack.push_back(node.child1);
+                    stack.push_back(node.child2);
+                }
+            }
+            StackBuffer().swap(stack);
+        }
+
+        void Clear() {
+            m_nodes.clear();
+            m_root = NullNode;
+            m_freeList = NullNode;
+            m_leafCount = 0;
+        }
+
+        size_t Count() const { return m_leafCount; }
+
+        // Longest root-to-leaf path (0 for a single leaf or an empty tree)
+        int32_t GetHeight() const { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+
+    private:
+        static std::vector<int32_t>& StackBuffer() {
+            static thread_local std::vector<int32_t> stack;
+            return stack;
+        }
+
+        int32_t AllocateNode() {
+            if (m_freeList == NullNode) {
+                m_nodes.emplace_back();
+                return static_cast<int32_t>(m_nodes.size() - 1);
+            }
+            int32_t node = m_freeList;
+            m_freeList = m_nodes[node].parent;
+            m_nodes[node] = Node();
+            return node;
+        }
+
+        void FreeNode(int32_t node) {
+            m_nodes[node].parent = m_freeList;
+            m_nodes[node].height = -1;
+            m_freeList = node;
+        }
+
+        void InsertLeaf(int32_t leaf) {
+            if (m_root == NullNode) {
+                m_root = leaf;
+                m_nodes[leaf].parent = NullNode;
+                return;
+            }
+
+            // Walk down picking the child whose box grows least (perimeter heuristic)
+            AABB leafBounds = m_nodes[leaf].bounds;
+            int32_t index = m_root;
+            while (!m_nodes[index].IsLeaf()) {
+                const Node& node = m_nodes[index];
+                float perimeter = node.bounds.GetPerimeter();
+                float combined = AABB::Union(node.bounds, leafBounds).GetPerimeter();
+
+                // Cost of making a new parent here, and the growth pushed onto descendants
+                float cost = 2.0f * combined;
+                float inheritance = 2.0f * (combined - perimeter);
+
+                float cost1 = ChildCost(node.child1, leafBounds) + inheritance;
+                float cost2 = ChildCost(node.child2, leafBounds) + inheritance;
+                if (cost < cost1 && cost < cost2) break;
+                index = cost1 < cost2 ? node.child1 : node.child2;
+            }
+
+            // New parent for the chosen sibling and the leaf
+            int32_t sibling = index;
+            int32_t oldParent = m_nodes[sibling].parent;
+            int32_t newParent = AllocateNode();
+            m_nodes[newParent].parent = oldParent;
+            m_nodes[newParent].bounds = AABB::Union(leafBounds, m_nodes[sibling].bounds);
+            m_nodes[newParent].height = m_nodes[sibling].height + 1;
+            m_nodes[newParent].child1 = sibling;
+            m_nodes[newParent].child2 = leaf;
+            m_nodes[sibling].parent = newParent;
+            m_nodes[leaf].parent = newParent;
+
+            if (oldParent == NullNode) {
+                m_root = newParent;
+            } else if (m_nodes[oldParent].child1 == sibling) {
+                m_nodes[oldParent].child1 = newParent;
+            } else {
+                m_nodes[oldParent].child2 = newParent;
+            }
+
+            Refit(m_nodes[leaf].parent);
+        }
+
+        float ChildCost(int32_t child, const AABB& leafBounds) const {
+            const Node& node = m_nodes[child];
+            float combined = AABB::Union(leafBounds, node.bounds).GetPerimeter();
+            return node.IsLeaf() ? combined : combined - node.bounds.GetPerimeter();
+        }
+
+        void RemoveLeaf(int32_t leaf) {
+            if (leaf == m_root) {
+                m_root = NullNode;
+                return;
+            }
+
+            // The sibling takes the parent's place
+            int32_t parent = m_nodes[leaf].parent;
+            int32_t grandParent = m_nodes[parent].parent;
+            int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+            if (grandParent == NullNode) {
+                m_root = sibling;
+                m_nodes[sibling].parent = NullNode;
+                FreeNode(parent);
+                return;
+            }
+
+            if (m_nodes[grandParent].child1 == parent) {
+                m_nodes[grandParent].child1 = sibling;
+            } else {
+                m_nodes[grandParent].child2 = sibling;
+            }
+            m_nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+            Refit(grandParent);
+        }
+
+        // Rebalance and recompute boxes/heights from index up to the root
+        void Refit(int32_t index) {
+            while (index != NullNode) {
+                index = Balance(index);
+                Node& node = m_nodes[index];
+                node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+                node.bounds = AABB::Union(m_nodes[node.child1].bounds, m_nodes[node.child2].bounds);
+                index = node.parent;
+            }
+        }
+
+        // If one child of a is more than one level taller than the other, rotate the taller
+        // child up into a's place. Returns the index now at a's position.
+        int32_t Balance(int32_t a) {
+            Node& nodeA = m_nodes[a];
+            if (nodeA.IsLeaf() || nodeA.height < 2) return a;
+
+            int32_t b = nodeA.child1;
+            int32_t c = nodeA.child2;
+            int32_t balance = m_nodes[c].height - m_nodes[b].height;
+            if (balance > 1) return Rotate(a, c, b);
+            if (balance < -1) return Rotate(a, b, c);
+            return a;
+        }
+
+        // Promote child "up" of a; "other" stays under a. up's shorter child moves across to a.
+        int32_t Rotate(int32_t a, int32_t up, int32_t other) {
+            Node& nodeA = m_nodes[a];
+            Node& nodeUp = m_nodes[up];
+            int32_t f = nodeUp.child1;
+            int32_t g = nodeUp.child2;
+
+            // up takes a's place
+            nodeUp.child1 = a;
+            nodeUp.parent = nodeA.parent;
+            nodeA.parent = up;
+            if (nodeUp.parent == NullNode) {
+                m_root = up;
+            } else if (m_nodes[nodeUp.parent].child1 == a) {
+                m_nodes[nodeUp.parent].child1 = up;
+            } else {
+                m_nodes[nodeUp.parent].child2 = up;
+            }
+
+            // Keep the taller grandchild under up, hand the shorter one to a
+            int32_t keep = m_nodes[f].height > m_nodes[g].height ? f : g;
+            int32_t give = keep == f ? g : f;
+            nodeUp.child2 = keep;
+            if (nodeA.child1 == up) {
+                nodeA.child1 = give;
+            } else {
+                nodeA.child2 = give;
+            }
+            m_nodes[give].parent = a;
+
+            nodeA.bounds = AABB::Union(m_nodes[other].bounds, m_nodes[give].bounds);
+            nodeA.height = 1 + std::max(m_nodes[other].height, m_nodes[give].height);
+            nodeUp.bounds = AABB::Union(nodeA.bounds, m_nodes[keep].bounds);
+            nodeUp.height = 1 + std::max(nodeA.height, m_nodes[keep].height);
+            return up;
+        }
+    };
+}
+#endif
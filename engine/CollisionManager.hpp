@@ -1,9 +1,19 @@
 #ifndef COLLISION_MANAGER_H
 #define COLLISION_MANAGER_H
+#include "engine/AABB.hpp"
+#include "engine/AABBTree.hpp"
 #include "engine/Entity.hpp"
 #include "engine/CollisionRectangle.hpp"
+#include "engine/PackedBounds.hpp"
+#include "engine/SpatialHash.hpp"
+#include "engine/StaticBVH.hpp"
+#include "engine/SweepAndPrune.hpp"
+#include "engine/TagRegistry.hpp"
+#include "engine/ThreadPool.hpp"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
-#include <functional>
+#include <algorithm>
 
 namespace Engine {
     // Interface for entities that can collide
@@ -12,98 +22,1129 @@ namespace Engine {
         virtual ~ICollidable() = default;
         virtual CollisionRectangle<float>* GetCollider() = 0;
         virtual Entity* AsEntity() = 0;
+
+        // Contact callbacks dispatched by CollisionManager::Step
+        virtual void OnCollisionEnter(Entity* other) { (void)other; }
+        virtual void OnCollisionStay(Entity* other) { (void)other; }
+        virtual void OnCollisionExit(Entity* other) { (void)other; }
+    };
+
+    // How queries find candidate colliders before the exact rectangle test
+    enum class Broadphase {
+        BruteForce,  // Test every registered collider
+        SpatialHash, // Uniform grid - see SetCellSize. Best when colliders are similar in size
+        AABBTree,    // Dynamic bounding volume tree - copes with mixed sizes, see SetTreeMargin
+        SweepAndPrune, // Sorted endpoints kept across frames - cheapest when most colliders barely move
+        PackedScan     // Brute force over packed copies of the cached boxes, several per SIMD compare
+    };
+
+    // Collision layer index (0-31) and a set of layers as one bit per layer
+    using CollisionLayer = uint8_t;
+    using CollisionLayerMask = uint32_t;
+
+    // A pair of colliders that started or stopped overlapping (sweep-and-prune only)
+    struct OverlapEvent {
+        ICollidable* a; // Registered before b
+        ICollidable* b;
+        bool began;
+    };
+
+    // First collider met by CollisionManager::Sweep
+    struct SweepHit {
+        ICollidable* collidable = nullptr;
+        Entity* entity = nullptr;
+        float time = 1.0f;  // Fraction of the displacement travelled before touching (0-1)
+        Vector2f normal;    // Axis normal of the face that was hit, pointing back at the mover
+    };
+
+    // First collider met by CollisionManager::Raycast
+    struct RaycastHit {
+        ICollidable* collidable = nullptr;
+        Entity* entity = nullptr;
+        float time = 1.0f;  // Fraction of the ray travelled before the hit (0-1)
+        Vector2f point;     // Where the ray enters the collider
+        Vector2f normal;    // Axis normal of the face entered (zero if the ray starts inside)
     };
 
     class CollisionManager {
     private:
-        std::vector<ICollidable*> m_collidables;
+        enum class DeferredKind { Register, RegisterStatic, Unregister, Update };
+
+        struct DeferredOp {
+            ICollidable* collidable;
+            DeferredKind kind;
+            CollisionLayer layer;
+            size_t source; // Recording order key - ops are applied sorted by it
+        };
+
+        // Per-collider broadphase data. Ids are reused after Unregister, so queries order
+        // results by registration sequence instead, matching the brute-force scan.
+        struct Proxy {
+            ICollidable* collidable = nullptr;
+            std::vector<Entity*> contacts; // Cached by Step, in registration order
+            AABB bounds;                 // Cached - refreshed by UpdateCollider/Update
+            SpatialHash::CellRange cells;
+            int32_t treeNode = AABBTree::NullNode;
+            uint64_t order = 0;
+            uint32_t packedIndex = 0;    // Position in m_collidables and m_packedBounds
+            CollisionLayer layer = 0;
+            bool hasBounds = false;      // False when the collider has no rectangle
+            bool isStatic = false;       // Lives in m_staticTree, not the dynamic broadphase
+        };
+
+        // Statics order after every dynamic collider, so merged results stay sorted by order
+        static constexpr uint64_t StaticOrderBit = uint64_t(1) << 63;
+
+        struct LayerEntry {
+            uint64_t order;
+            ICollidable* collidable;
+        };
+
+        std::vector<ICollidable*> m_collidables; // Registration order
+        PackedBounds m_packedBounds;             // Cached boxes, parallel to m_collidables
+        std::vector<Proxy> m_proxies;
+        std::vector<uint32_t> m_freeProxies;
+        std::unordered_map<ICollidable*, uint32_t> m_proxyIds;
+        uint64_t m_nextOrder = 0;
+
+        // Colliders per layer, each in registration order, and which layers each layer hits
+        std::vector<LayerEntry> m_layerColliders[32];
+        CollisionLayerMask m_layerMatrix[32];
+        CollisionLayerMask m_populatedLayers = 0;
+
+        // Colliders that never move, kept out of the dynamic broadphase. Statics registered
+        // since the last BakeStatic are scanned linearly until the next bake; unregistered
+        // ones keep their proxy id reserved until then, since the tree still refers to it.
+        std::vector<uint32_t> m_statics;        // Registration order
+        std::vector<uint32_t> m_unbakedStatics;
+        std::vector<uint32_t> m_retiredStatics;
+        StaticBVH m_staticTree;
+
+        Broadphase m_broadphase = Broadphase::BruteForce;
+        SpatialHash m_spatialHash;
+        AABBTree m_tree;
+        SweepAndPrune m_sweepAndPrune;
+        std::vector<OverlapEvent> m_overlapEvents;
+        bool m_recordOverlapEvents = false;
+
+        // Touching pairs found by the last Step, sorted by registration order of (a, b)
+        struct Contact {
+            uint64_t orderA;
+            uint64_t orderB;
+            ICollidable* a;
+            ICollidable* b;
+        };
+
+        enum class ContactKind { Enter, Stay, Exit };
+
+        struct ContactEvent {
+            ICollidable* self;
+            ICollidable* other;
+            ContactKind kind;
+        };
+
+        std::vector<Contact> m_contacts;
+        std::vector<Contact> m_previousContacts;
+        std::vector<ContactEvent> m_contactEvents;
+
+        ThreadPool* m_threadPool = nullptr;
+        size_t m_pairChunkSize = 256;
+        std::vector<std::vector<Contact>> m_chunkContacts; // Per ParallelFor chunk, kept for capacity
+
+        std::vector<std::vector<DeferredOp>> m_deferredOps; // Per worker thread
+        std::vector<size_t> m_deferredSources;             // Per worker thread, see SetDeferredSource
+        std::vector<DeferredOp> m_deferredScratch;
+        bool m_deferring = false;
 
     public:
-        CollisionManager() = default;
+        static constexpr size_t MaxLayers = 32;
+        static constexpr CollisionLayerMask AllLayers = 0xFFFFFFFFu;
 
-        // Register a collidable entity
-        void Register(ICollidable* collidable) {
+        static constexpr CollisionLayerMask LayerBit(CollisionLayer layer) {
+            return layer < MaxLayers ? (CollisionLayerMask(1) << layer) : 0;
+        }
+
+        CollisionManager() {
+            for (CollisionLayerMask& mask : m_layerMatrix) {
+                mask = AllLayers;
+            }
+        }
+
+        // Register a collidable entity on a layer (repeat calls are ignored - see SetLayer)
+        void Register(ICollidable* collidable, CollisionLayer layer = 0) {
+            if (DeferOp(collidable, DeferredKind::Register, layer)) return;
+            if (!collidable || m_proxyIds.count(collidable) || layer >= MaxLayers) return;
+
+            uint32_t id = AllocateProxy(collidable);
+            Proxy& proxy = m_proxies[id];
+            proxy.packedIndex = static_cast<uint32_t>(m_collidables.size());
+            proxy.layer = layer;
             m_collidables.push_back(collidable);
+            m_packedBounds.PushBack();
+            m_packedBounds.SetLayerBits(proxy.packedIndex, LayerBit(layer));
+            m_layerColliders[layer].push_back({proxy.order, collidable}); // Newest order, so still sorted
+            m_populatedLayers |= LayerBit(layer);
+
+            RefreshBounds(proxy);
+            InsertProxy(id);
         }
 
-        // Unregister a collidable entity
+        // Register a collider that never moves. Statics skip the dynamic broadphase and are
+        // only ever tested against dynamic colliders; static-vs-static pairs are never
+        // evaluated. Their boxes are read once here - call BakeStatic after registering a
+        // level's statics (e.g. from Scene::Init) so the build cost lands in scene load.
+        void RegisterStatic(ICollidable* collidable, CollisionLayer layer = 0) {
+            if (DeferOp(collidable, DeferredKind::RegisterStatic, layer)) return;
+            if (!collidable || m_proxyIds.count(collidable) || layer >= MaxLayers) return;
+
+            uint32_t id = AllocateProxy(collidable);
+            Proxy& proxy = m_proxies[id];
+            proxy.order |= StaticOrderBit;
+            proxy.layer = layer;
+            proxy.isStatic = true;
+            auto* collider = collidable->GetCollider();
+            proxy.hasBounds = collider && collider->GetRectangle();
+            if (proxy.hasBounds) {
+                proxy.bounds = AABB::FromRectangle(*collider->GetRectangle());
+            }
+            m_statics.push_back(id);
+            m_unbakedStatics.push_back(id);
+        }
+
+        // Build the static tree from every registered static. Until the next bake, statics
+        // registered afterwards are scanned one by one.
+        void BakeStatic() {
+            std::vector<StaticBVH::Entry> entries;
+            entries.reserve(m_statics.size());
+            for (uint32_t id : m_statics) {
+                if (m_proxies[id].hasBounds) entries.push_back({m_proxies[id].bounds, id});
+            }
+            m_staticTree.Build(std::move(entries));
+            m_unbakedStatics.clear();
+            m_freeProxies.insert(m_freeProxies.end(), m_retiredStatics.begin(), m_retiredStatics.end());
+            m_retiredStatics.clear();
+        }
+
+        size_t StaticCount() const { return m_statics.size(); }
+        bool IsStatic(ICollidable* collidable) const {
+            auto it = m_proxyIds.find(collidable);
+            return it != m_proxyIds.end() && m_proxies[it->second].isStatic;
+        }
+
+        // Unregister a collidable entity (dynamic or static)
         void Unregister(ICollidable* collidable) {
-            m_collidables.erase(
-                std::remove(m_collidables.begin(), m_collidables.end(), collidable),
-                m_collidables.end()
-            );
+            if (DeferOp(collidable, DeferredKind::Unregister)) return;
+            auto it = m_proxyIds.find(collidable);
+            if (it == m_proxyIds.end()) return;
+
+            uint32_t id = it->second;
+            if (m_proxies[id].isStatic) {
+                UnregisterStatic(collidable, it);
+                return;
+            }
+            if (m_proxies[id].hasBounds) {
+                RemoveProxy(id, m_proxies[id].cells);
+            }
+            bool hadContacts = !m_proxies[id].contacts.empty();
+            uint32_t packedIndex = m_proxies[id].packedIndex;
+            RemoveFromLayer(m_proxies[id]);
+            m_proxies[id] = Proxy();
+            m_freeProxies.push_back(id);
+            m_proxyIds.erase(it);
+            m_collidables.erase(m_collidables.begin() + packedIndex);
+            m_packedBounds.Erase(packedIndex);
+            for (size_t i = packedIndex; i < m_collidables.size(); i++) {
+                m_proxies[m_proxyIds[m_collidables[i]]].packedIndex = static_cast<uint32_t>(i);
+            }
+            if (hadContacts) {
+                DropContacts(collidable);
+            }
+        }
+
+        // Re-read a collider's rectangle after it moved or resized. With any broadphase but
+        // BruteForce, queries only see a collider's new position once this (or Update) has been called.
+        // Statics ignore it.
+        void UpdateCollider(ICollidable* collidable) {
+            if (DeferOp(collidable, DeferredKind::Update)) return;
+            auto it = m_proxyIds.find(collidable);
+            if (it == m_proxyIds.end()) return;
+
+            uint32_t id = it->second;
+            Proxy& proxy = m_proxies[id];
+            if (proxy.isStatic) return; // Baked - unregister and re-register to move one
+            bool hadBounds = proxy.hasBounds;
+            SpatialHash::CellRange oldCells = proxy.cells;
+            RefreshBounds(proxy);
+            if (!hadBounds) {
+                InsertProxy(id);
+                return;
+            }
+            if (!proxy.hasBounds) {
+                RemoveProxy(id, oldCells); // Lost its rectangle
+                return;
+            }
+            switch (m_broadphase) {
+                case Broadphase::SpatialHash: m_spatialHash.Move(id, oldCells, proxy.cells); break;
+                case Broadphase::AABBTree: m_tree.Move(proxy.treeNode, proxy.bounds); break; // Refit only if it left its fat box
+                case Broadphase::SweepAndPrune:
+                    m_sweepAndPrune.Move(id, proxy.bounds);
+                    FlushPairEvents();
+                    break;
+                case Broadphase::BruteForce:
+                case Broadphase::PackedScan: break;
+            }
+        }
+
+        // Find every touching pair once for the frame, cache them for GetContacts and
+        // dispatch OnCollisionEnter/Stay/Exit to both colliders of each pair. Entities that
+        // start touching are woken. Call once per frame after colliders have moved (and been
+        // refreshed, for a spatial broadphase).
+        void Step() {
+            m_previousContacts.swap(m_contacts);
+            m_contacts.clear();
+            for (ICollidable* collidable : m_collidables) {
+                m_proxies[m_proxyIds[collidable]].contacts.clear();
+            }
+            for (uint32_t id : m_statics) {
+                m_proxies[id].contacts.clear();
+            }
+
+            if (m_threadPool && m_threadPool->GetThreadCount() > 1 && m_collidables.size() > m_pairChunkSize) {
+                FindContactsParallel();
+            } else {
+                FindContacts(0, m_collidables.size(), m_contacts);
+            }
+
+            // Walk old and new pairs together: new only = enter, both = stay, old only = exit
+            m_contactEvents.clear();
+            size_t oldIndex = 0;
+            for (const Contact& contact : m_contacts) {
+                m_proxies[m_proxyIds[contact.a]].contacts.push_back(contact.b->AsEntity());
+                m_proxies[m_proxyIds[contact.b]].contacts.push_back(contact.a->AsEntity());
+
+                while (oldIndex < m_previousContacts.size() && IsBefore(m_previousContacts[oldIndex], contact)) {
+                    PushContactEvents(m_previousContacts[oldIndex++], ContactKind::Exit);
+                }
+                bool stayed = oldIndex < m_previousContacts.size() && !IsBefore(contact, m_previousContacts[oldIndex]);
+                if (stayed) {
+                    oldIndex++;
+                } else {
+                    // A new contact wakes sleeping or dormant entities on both sides, before
+                    // any callback runs
+                    Touch(contact.a);
+                    Touch(contact.b);
+                }
+                PushContactEvents(contact, stayed ? ContactKind::Stay : ContactKind::Enter);
+            }
+            while (oldIndex < m_previousContacts.size()) {
+                PushContactEvents(m_previousContacts[oldIndex++], ContactKind::Exit);
+            }
+            DispatchContactEvents();
+        }
+
+        // Entities touching collidable as of the last Step (empty if not registered)
+        const std::vector<Entity*>& GetContacts(ICollidable* collidable) const {
+            static const std::vector<Entity*> none;
+            auto it = m_proxyIds.find(collidable);
+            return it == m_proxyIds.end() ? none : m_proxies[it->second].contacts;
+        }
+
+        // Whether collidable touched anything with the tag as of the last Step
+        bool HasContactWithTag(ICollidable* collidable, TagId tag) const {
+            for (Entity* other : GetContacts(collidable)) {
+                if (other->HasTag(tag)) return true;
+            }
+            return false;
+        }
+
+        size_t GetContactCount() const { return m_contacts.size(); }
+
+        // Find Step's pairs across a worker pool (nullptr = serial). Each chunk of chunkSize
+        // colliders queries the shared broadphase into its own buffer and the buffers are
+        // joined in chunk order, so the pairs and callbacks match a serial Step exactly.
+        // The pool is not owned and must outlive the manager's Steps.
+        void SetThreadPool(ThreadPool* threadPool, size_t chunkSize = 256) {
+            m_threadPool = threadPool;
+            m_pairChunkSize = std::max<size_t>(1, chunkSize);
+        }
+
+        ThreadPool* GetThreadPool() const { return m_threadPool; }
+
+        // Refresh every collider (for scenes that move colliders without calling UpdateCollider)
+        void Update() {
+            for (ICollidable* collidable : m_collidables) {
+                UpdateCollider(collidable);
+            }
+        }
+
+        // Move a registered collider to another layer, keeping its registration order
+        void SetLayer(ICollidable* collidable, CollisionLayer layer) {
+            auto it = m_proxyIds.find(collidable);
+            if (it == m_proxyIds.end() || layer >= MaxLayers) return;
+            Proxy& proxy = m_proxies[it->second];
+            if (proxy.layer == layer) return;
+            if (proxy.isStatic) {
+                proxy.layer = layer; // Statics are filtered by proxy, not by layer list
+                return;
+            }
+
+            RemoveFromLayer(proxy);
+            proxy.layer = layer;
+            auto& entries = m_layerColliders[layer];
+            auto position = std::lower_bound(entries.begin(), entries.end(), proxy.order,
+                [](const LayerEntry& entry, uint64_t order) { return entry.order < order; });
+            entries.insert(position, {proxy.order, collidable});
+            m_populatedLayers |= LayerBit(layer);
+            m_packedBounds.SetLayerBits(proxy.packedIndex, LayerBit(layer));
+        }
+
+        // Layer of a registered collider (0 if not registered)
+        CollisionLayer GetLayer(ICollidable* collidable) const {
+            auto it = m_proxyIds.find(collidable);
+            return it == m_proxyIds.end() ? 0 : m_proxies[it->second].layer;
+        }
+
+        // Whether colliders on layer a and layer b see each other. Every pair interacts by
+        // default; the matrix is kept symmetric so a pair is never seen from one side only.
+        void SetLayersInteract(CollisionLayer a, CollisionLayer b, bool interact) {
+            if (a >= MaxLayers || b >= MaxLayers) return;
+            if (interact) {
+                m_layerMatrix[a] |= LayerBit(b);
+                m_layerMatrix[b] |= LayerBit(a);
+            } else {
+                m_layerMatrix[a] &= ~LayerBit(b);
+                m_layerMatrix[b] &= ~LayerBit(a);
+            }
+        }
+
+        bool DoLayersInteract(CollisionLayer a, CollisionLayer b) const {
+            return a < MaxLayers && (m_layerMatrix[a] & LayerBit(b)) != 0;
+        }
+
+        // Layers that colliders on layer see
+        CollisionLayerMask GetLayerMask(CollisionLayer layer) const {
+            return layer < MaxLayers ? m_layerMatrix[layer] : 0;
+        }
+
+        size_t CountInLayer(CollisionLayer layer) const {
+            return layer < MaxLayers ? m_layerColliders[layer].size() : 0;
+        }
+
+        // Switch broadphase - every query returns the same results in the same order either way
+        void SetBroadphase(Broadphase broadphase) {
+            if (broadphase == m_broadphase) return;
+            m_broadphase = broadphase;
+            RebuildBroadphase();
+        }
+
+        Broadphase GetBroadphase() const { return m_broadphase; }
+
+        // Spatial hash cell size - roughly the size of a typical collider works well
+        void SetCellSize(float cellSize) {
+            m_spatialHash.SetCellSize(cellSize);
+            if (m_broadphase == Broadphase::SpatialHash) RebuildBroadphase();
+        }
+
+        float GetCellSize() const { return m_spatialHash.GetCellSize(); }
+
+        // How far past its box the tree fattens each collider. Larger margins mean fewer
+        // re-inserts for fast movers but more false candidates per query.
+        void SetTreeMargin(float margin) {
+            m_tree.SetMargin(margin);
+            if (m_broadphase == Broadphase::AABBTree) RebuildBroadphase();
+        }
+
+        float GetTreeMargin() const { return m_tree.GetMargin(); }
+
+        size_t Count() const { return m_collidables.size(); }
+
+        // Record sweep-and-prune pair changes for GetOverlapEvents. Off by default so nobody
+        // pays for (or accumulates) events they never read.
+        void SetOverlapEventsEnabled(bool enabled) {
+            m_recordOverlapEvents = enabled;
+            if (!enabled) m_overlapEvents.clear();
+        }
+
+        // Pairs whose boxes started or stopped overlapping since the last ClearOverlapEvents,
+        // in the order they happened. Boxes are the broadphase bounds (touching counts), so
+        // a pair may begin here before the exact rectangle test reports a collision.
+        const std::vector<OverlapEvent>& GetOverlapEvents() const { return m_overlapEvents; }
+        void ClearOverlapEvents() { m_overlapEvents.clear(); }
+
+        // Number of overlapping box pairs (sweep-and-prune only)
+        size_t GetOverlapPairCount() const { return m_sweepAndPrune.GetPairCount(); }
+
+        // While deferring, Register/Unregister/UpdateCollider calls made from thread pool
+        // workers are buffered per worker. EndDeferred applies them ordered by the source key
+        // each was recorded under (EntityManager uses the entity's update index), so the
+        // result doesn't depend on which worker ran which entity.
+        void BeginDeferred(size_t workerCount) {
+            if (m_deferredOps.size() < workerCount) {
+                m_deferredOps.resize(workerCount);
+                m_deferredSources.resize(workerCount, 0);
+            }
+            m_deferring = true;
+        }
+
+        // Source key for ops the given worker records from now on
+        void SetDeferredSource(size_t worker, size_t source) {
+            if (worker < m_deferredSources.size()) m_deferredSources[worker] = source;
+        }
+
+        void EndDeferred() {
+            m_deferring = false;
+            m_deferredScratch.clear();
+            for (auto& ops : m_deferredOps) {
+                m_deferredScratch.insert(m_deferredScratch.end(), ops.begin(), ops.end());
+                ops.clear();
+            }
+            // Stable, so ops from one source keep the order they were recorded in
+            std::stable_sort(m_deferredScratch.begin(), m_deferredScratch.end(),
+                [](const DeferredOp& a, const DeferredOp& b) { return a.source < b.source; });
+            for (const DeferredOp& op : m_deferredScratch) {
+                switch (op.kind) {
+                    case DeferredKind::Register: Register(op.collidable, op.layer); break;
+                    case DeferredKind::RegisterStatic: RegisterStatic(op.collidable, op.layer); break;
+                    case DeferredKind::Unregister: Unregister(op.collidable); break;
+                    case DeferredKind::Update: UpdateCollider(op.collidable); break;
+                }
+            }
+            m_deferredScratch.clear();
         }
 
         // Clear all registered collidables
         void Clear() {
             m_collidables.clear();
+            for (auto& entries : m_layerColliders) {
+                entries.clear();
+            }
+            m_populatedLayers = 0;
+            m_statics.clear();
+            m_unbakedStatics.clear();
+            m_retiredStatics.clear();
+            m_staticTree.Clear();
+            m_packedBounds.Clear();
+            m_proxies.clear();
+            m_freeProxies.clear();
+            m_proxyIds.clear();
+            m_spatialHash.Clear();
+            m_tree.Clear();
+            m_sweepAndPrune.Clear();
+            m_overlapEvents.clear();
+            m_contacts.clear();
+            m_previousContacts.clear();
         }
 
-        // Get all entities colliding with the given collidable
+        // Get all entities colliding with the given collidable. Queries only see colliders on
+        // layers the caller's layer interacts with (an unregistered caller sees every layer).
         std::vector<Entity*> GetCollisions(ICollidable* collidable) {
+            return GetCollisionsInLayers(collidable, AllLayers);
+        }
+
+        // Get the colliding entities on the given layers only - the other layers' colliders
+        // are never visited
+        std::vector<Entity*> GetCollisionsInLayers(ICollidable* collidable, CollisionLayerMask layers) {
             std::vector<Entity*> results;
             auto* collider = collidable->GetCollider();
             if (!collider) return results;
 
-            for (auto* other : m_collidables) {
-                if (other == collidable) continue;
+            ForEachCandidate(collidable, *collider, QueryMask(collidable, layers), [&](ICollidable* other) {
                 auto* otherCollider = other->GetCollider();
                 if (otherCollider && collider->IsColliding(*otherCollider)) {
-                    results.push_back(other->AsEntity());
+                    results.push_back(Touch(other));
                 }
-            }
+                return true;
+            });
             return results;
         }
 
         // Get all entities with a specific tag that are colliding with the given collidable
         std::vector<Entity*> GetCollisionsWithTag(ICollidable* collidable, const std::string& tag) {
+            return GetCollisionsWithTag(collidable, TagRegistry::Find(tag));
+        }
+
+        std::vector<Entity*> GetCollisionsWithTag(ICollidable* collidable, TagId tag) {
             std::vector<Entity*> results;
             auto* collider = collidable->GetCollider();
             if (!collider) return results;
 
-            for (auto* other : m_collidables) {
-                if (other == collidable) continue;
-                Entity* entity = other->AsEntity();
-                if (!entity->GetTags().count(tag)) continue;
-
+            ForEachCandidate(collidable, *collider, QueryMask(collidable, AllLayers), [&](ICollidable* other) {
+                if (!other->AsEntity()->HasTag(tag)) return true;
                 auto* otherCollider = other->GetCollider();
                 if (otherCollider && collider->IsColliding(*otherCollider)) {
-                    results.push_back(entity);
+                    results.push_back(Touch(other));
                 }
-            }
+                return true;
+            });
             return results;
         }
 
         // Check if collidable is colliding with any entity with the given tag
         bool IsCollidingWithTag(ICollidable* collidable, const std::string& tag) {
+            return IsCollidingWithTag(collidable, TagRegistry::Find(tag));
+        }
+
+        bool IsCollidingWithTag(ICollidable* collidable, TagId tag) {
             auto* collider = collidable->GetCollider();
             if (!collider) return false;
 
-            for (auto* other : m_collidables) {
-                if (other == collidable) continue;
-                Entity* entity = other->AsEntity();
-                if (!entity->GetTags().count(tag)) continue;
+            bool colliding = false;
+            ForEachCandidate(collidable, *collider, QueryMask(collidable, AllLayers), [&](ICollidable* other) {
+                if (!other->AsEntity()->HasTag(tag)) return true;
+                auto* otherCollider = other->GetCollider();
+                if (otherCollider && collider->IsColliding(*otherCollider)) {
+                    Touch(other);
+                    colliding = true;
+                    return false; // Stop at the first hit
+                }
+                return true;
+            });
+            return colliding;
+        }
 
+        // Check if collidable is colliding with anything on the given layers
+        bool IsCollidingWithLayers(ICollidable* collidable, CollisionLayerMask layers) {
+            auto* collider = collidable->GetCollider();
+            if (!collider) return false;
+
+            bool colliding = false;
+            ForEachCandidate(collidable, *collider, QueryMask(collidable, layers), [&](ICollidable* other) {
                 auto* otherCollider = other->GetCollider();
                 if (otherCollider && collider->IsColliding(*otherCollider)) {
-                    return true;
+                    Touch(other);
+                    colliding = true;
+                    return false; // Stop at the first hit
                 }
-            }
-            return false;
+                return true;
+            });
+            return colliding;
         }
 
-        // Iterate over all collisions with a callback
-        void ForEachCollision(ICollidable* collidable, const std::function<void(Entity*)>& callback) {
+        // Iterate over all collisions with a callback (templated so lambdas inline), optionally
+        // restricted to some layers
+        template<typename Fn>
+        void ForEachCollision(ICollidable* collidable, Fn&& callback, CollisionLayerMask layers = AllLayers) {
             auto* collider = collidable->GetCollider();
             if (!collider) return;
 
-            for (auto* other : m_collidables) {
-                if (other == collidable) continue;
+            ForEachCandidate(collidable, *collider, QueryMask(collidable, layers), [&](ICollidable* other) {
                 auto* otherCollider = other->GetCollider();
                 if (otherCollider && collider->IsColliding(*otherCollider)) {
-                    callback(other->AsEntity());
+                    callback(Touch(other));
+                }
+                return true;
+            });
+        }
+
+        // Move mover's collider by displacement and find the first collider it would touch on
+        // the way, so fast movers can't tunnel through thin ones between ticks. Candidates
+        // come from the broadphase around the whole path (with a BruteForce or spatial
+        // broadphase, only as fresh as their last UpdateCollider). Ties go to the earliest
+        // registered; a collider already overlapping the mover hits at time 0 with a zero normal.
+        bool Sweep(ICollidable* mover, const Vector2f& displacement, SweepHit& hit, CollisionLayerMask layers = AllLayers) {
+            hit = SweepHit();
+            auto* collider = mover->GetCollider();
+            if (!collider || !collider->GetRectangle()) return false;
+
+            AABB start = AABB::FromRectangle(*collider->GetRectangle());
+            const float dx = displacement.GetX();
+            const float dy = displacement.GetY();
+            AABB end(start.minX + dx, start.minY + dy, start.maxX + dx, start.maxY + dy);
+
+            float bestTime = 2.0f;
+            ForEachInArea(AABB::Union(start, end), QueryMask(mover, layers), mover, [&](ICollidable* other, const AABB& box) {
+                float time, normalX, normalY;
+                if (start.Sweep(box, dx, dy, time, normalX, normalY) && time < bestTime) {
+                    bestTime = time;
+                    hit.collidable = other;
+                    hit.time = time;
+                    hit.normal = Vector2f(normalX, normalY);
+                }
+                return bestTime > 0.0f; // Nothing beats an overlap at the start
+            });
+            if (!hit.collidable) return false;
+            hit.entity = Touch(hit.collidable);
+            return true;
+        }
+
+        // Region queries for things that aren't colliders themselves (AI vision, explosions,
+        // mouse picking). Each one refills results in registration order (statics last),
+        // reusing its capacity, so a buffer kept across frames makes them allocation-free.
+        // Found entities are not woken - these aren't contacts. Returns the number found.
+
+        // Colliders overlapping area (same strict test as CollisionRectangle::IsColliding)
+        size_t QueryRect(const Rectangle<float>& area, std::vector<Entity*>& results, CollisionLayerMask layers = AllLayers) {
+            AABB bounds = AABB::FromRectangle(area);
+            return QueryArea(bounds, results, layers, [&bounds](const AABB& box) {
+                return box.minX < bounds.maxX && box.maxX > bounds.minX &&
+                       box.minY < bounds.maxY && box.maxY > bounds.minY;
+            });
+        }
+
+        // Colliders containing point (left/top edges inclusive, right/bottom exclusive)
+        size_t QueryPoint(const Vector2f& point, std::vector<Entity*>& results, CollisionLayerMask layers = AllLayers) {
+            const float x = point.GetX();
+            const float y = point.GetY();
+            return QueryArea(AABB(x, y, x, y), results, layers, [x, y](const AABB& box) {
+                return x >= box.minX && x < box.maxX && y >= box.minY && y < box.maxY;
+            });
+        }
+
+        // Colliders whose rectangle reaches inside the circle
+        size_t QueryRadius(const Vector2f& centre, float radius, std::vector<Entity*>& results, CollisionLayerMask layers = AllLayers) {
+            const float x = centre.GetX();
+            const float y = centre.GetY();
+            return QueryArea(AABB(x - radius, y - radius, x + radius, y + radius), results, layers, [=](const AABB& box) {
+                float dx = x - std::max(box.minX, std::min(x, box.maxX));
+                float dy = y - std::max(box.minY, std::min(y, box.maxY));
+                return dx * dx + dy * dy < radius * radius;
+            });
+        }
+
+        // First collider along the segment from origin to origin + ray, skipping ignore (e.g.
+        // the caster's own collider). A ray starting inside a collider hits it at time 0.
+        bool Raycast(const Vector2f& origin, const Vector2f& ray, RaycastHit& hit,
+                     CollisionLayerMask layers = AllLayers, ICollidable* ignore = nullptr) {
+            hit = RaycastHit();
+            const float dx = ray.GetX();
+            const float dy = ray.GetY();
+            AABB start(origin.GetX(), origin.GetY(), origin.GetX(), origin.GetY());
+            AABB path = AABB::Union(start, AABB(start.minX + dx, start.minY + dy, start.minX + dx, start.minY + dy));
+
+            float bestTime = 2.0f;
+            ForEachInArea(path, layers, ignore, [&](ICollidable* other, const AABB& box) {
+                float time, normalX, normalY;
+                if (start.Sweep(box, dx, dy, time, normalX, normalY) && time < bestTime) {
+                    bestTime = time;
+                    hit.collidable = other;
+                    hit.time = time;
+                    hit.normal = Vector2f(normalX, normalY);
+                }
+                return bestTime > 0.0f;
+            });
+            if (!hit.collidable) return false;
+            hit.entity = hit.collidable->AsEntity();
+            hit.point = Vector2f(origin.GetX() + dx * hit.time, origin.GetY() + dy * hit.time);
+            return true;
+        }
+
+    private:
+        template<typename Test>
+        size_t QueryArea(const AABB& bounds, std::vector<Entity*>& results, CollisionLayerMask layers, Test&& test) {
+            results.clear();
+            ForEachInArea(bounds, layers, nullptr, [&](ICollidable* other, const AABB& box) {
+                if (test(box)) results.push_back(other->AsEntity());
+                return true;
+            });
+            return results.size();
+        }
+
+        // Call fn(other, box) with the live box of every collider the broadphase offers for
+        // bounds. The candidate area is padded so boxes that only touch bounds (which the
+        // strict PackedScan test would drop) still reach the caller's own test.
+        template<typename Fn>
+        void ForEachInArea(const AABB& bounds, CollisionLayerMask layers, ICollidable* ignore, Fn&& fn) {
+            AABB padded = bounds.Expanded(1.0f);
+            Rectangle<float> area(Vector2f(padded.minX, padded.minY), Vector2f(padded.GetWidth(), padded.GetHeight()));
+            ForEachCandidateIn(ignore, &area, false, layers, [&](ICollidable* other) {
+                auto* collider = other->GetCollider();
+                if (!collider || !collider->GetRectangle()) return true;
+                return fn(other, AABB::FromRectangle(*collider->GetRectangle()));
+            });
+        }
+
+        // Call fn(other) for every collider on the given layers the broadphase can't rule
+        // out, in registration order, skipping self. fn returns false to stop early.
+        template<typename Fn>
+        void ForEachCandidate(ICollidable* self, const CollisionRectangle<float>& collider, CollisionLayerMask layers, Fn&& fn) {
+            ForEachCandidateIn(self, collider.GetRectangle(), true, layers, fn);
+        }
+
+        // Same, for an arbitrary area instead of self's collider. usePairs lets sweep-and-prune
+        // answer from self's pair list, which is only right when area is self's own box.
+        template<typename Fn>
+        void ForEachCandidateIn(ICollidable* self, const Rectangle<float>* area, bool usePairs, CollisionLayerMask layers, Fn&& fn) {
+            bool keepGoing = true;
+            ForEachDynamicCandidate(self, area, usePairs, layers, [&](ICollidable* other) {
+                keepGoing = fn(other);
+                return keepGoing;
+            });
+            if (keepGoing && area && !m_statics.empty()) {
+                ForEachStaticCandidate(self, AABB::FromRectangle(*area), layers, fn);
+            }
+        }
+
+        template<typename Fn>
+        void ForEachDynamicCandidate(ICollidable* self, const Rectangle<float>* area, bool usePairs, CollisionLayerMask layers, Fn&& fn) {
+            layers &= m_populatedLayers;
+            if (!layers) return;
+
+            if (m_broadphase == Broadphase::BruteForce) {
+                ForEachInLayers(layers, [&](ICollidable* other) {
+                    return other == self || fn(other);
+                });
+                return;
+            }
+
+            if (!area) return;
+
+            if (m_broadphase == Broadphase::PackedScan) {
+                // Already in registration order and already the exact test (on cached boxes)
+                m_packedBounds.ForEachOverlap(*area, [&](size_t index) {
+                    ICollidable* other = m_collidables[index];
+                    return other == self || fn(other);
+                }, layers);
+                return;
+            }
+
+            AABB bounds = AABB::FromRectangle(*area);
+
+            // Borrow this thread's scratch buffer (a nested query from fn gets a fresh one)
+            std::vector<uint32_t> candidates;
+            candidates.swap(ScratchBuffer());
+            auto collect = [&](uint32_t id) {
+                const Proxy& proxy = m_proxies[id];
+                if ((LayerBit(proxy.layer) & layers) && proxy.bounds.Overlaps(bounds)) {
+                    candidates.push_back(id);
+                }
+            };
+            if (m_broadphase == Broadphase::SpatialHash) {
+                m_spatialHash.Query(m_spatialHash.GetCellRange(bounds), collect);
+            } else if (m_broadphase == Broadphase::AABBTree) {
+                m_tree.Query(bounds, collect);
+            } else {
+                // The pair list is only as fresh as self's last UpdateCollider; unregistered
+                // colliders have no pairs and fall back to scanning the cached boxes
+                auto it = usePairs ? m_proxyIds.find(self) : m_proxyIds.end();
+                if (it != m_proxyIds.end() && m_proxies[it->second].hasBounds && !m_proxies[it->second].isStatic) {
+                    m_sweepAndPrune.ForEachOverlap(it->second, collect);
+                } else {
+                    ForEachInLayers(layers, [&](ICollidable* other) {
+                        uint32_t id = m_proxyIds.find(other)->second;
+                        if (m_proxies[id].hasBounds) collect(id);
+                        return true;
+                    });
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+                return m_proxies[a].order < m_proxies[b].order;
+            });
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+            for (uint32_t id : candidates) {
+                ICollidable* other = m_proxies[id].collidable;
+                if (other == self) continue;
+                if (!fn(other)) break;
+            }
+            candidates.clear();
+            ScratchBuffer().swap(candidates);
+        }
+
+        // Statics on the given layers whose boxes overlap bounds, in registration order
+        template<typename Fn>
+        void ForEachStaticCandidate(ICollidable* self, const AABB& bounds, CollisionLayerMask layers, Fn&& fn) {
+            std::vector<uint32_t> candidates;
+            candidates.swap(ScratchBuffer());
+            auto collect = [&](uint32_t id) {
+                const Proxy& proxy = m_proxies[id];
+                if (proxy.isStatic && (LayerBit(proxy.layer) & layers) && proxy.bounds.Overlaps(bounds)) {
+                    candidates.push_back(id);
+                }
+            };
+            m_staticTree.Query(bounds, collect); // Retired ids are reset proxies, so collect skips them
+            for (uint32_t id : m_unbakedStatics) {
+                if (m_proxies[id].hasBounds) collect(id);
+            }
+            std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+                return m_proxies[a].order < m_proxies[b].order;
+            });
+
+            for (uint32_t id : candidates) {
+                ICollidable* other = m_proxies[id].collidable;
+                if (other == self) continue;
+                if (!fn(other)) break;
+            }
+            candidates.clear();
+            ScratchBuffer().swap(candidates);
+        }
+
+        uint32_t AllocateProxy(ICollidable* collidable) {
+            uint32_t id;
+            if (!m_freeProxies.empty()) {
+                id = m_freeProxies.back();
+                m_freeProxies.pop_back();
+            } else {
+                id = static_cast<uint32_t>(m_proxies.size());
+                m_proxies.emplace_back();
+            }
+            Proxy& proxy = m_proxies[id];
+            proxy = Proxy();
+            proxy.collidable = collidable;
+            proxy.order = m_nextOrder++;
+            m_proxyIds.emplace(collidable, id);
+            return id;
+        }
+
+        void UnregisterStatic(ICollidable* collidable, std::unordered_map<ICollidable*, uint32_t>::iterator it) {
+            uint32_t id = it->second;
+            bool hadContacts = !m_proxies[id].contacts.empty();
+            m_statics.erase(std::find(m_statics.begin(), m_statics.end(), id));
+            auto unbaked = std::find(m_unbakedStatics.begin(), m_unbakedStatics.end(), id);
+            if (unbaked != m_unbakedStatics.end()) {
+                m_unbakedStatics.erase(unbaked);
+                m_freeProxies.push_back(id); // Never made it into the tree
+            } else {
+                m_retiredStatics.push_back(id);
+            }
+            m_proxies[id] = Proxy();
+            m_proxyIds.erase(it);
+            if (hadContacts) {
+                DropContacts(collidable);
+            }
+        }
+
+        // Call fn(collidable) for every collider on the given layers in registration order,
+        // merging the per-layer lists. fn returns false to stop early.
+        template<typename Fn>
+        void ForEachInLayers(CollisionLayerMask layers, Fn&& fn) const {
+            if (layers == m_populatedLayers) {
+                for (ICollidable* collidable : m_collidables) {
+                    if (!fn(collidable)) return;
+                }
+                return;
+            }
+
+            const std::vector<LayerEntry>* lists[MaxLayers];
+            size_t positions[MaxLayers];
+            size_t listCount = 0;
+            for (CollisionLayer layer = 0; layer < MaxLayers; layer++) {
+                if (layers & LayerBit(layer)) {
+                    lists[listCount] = &m_layerColliders[layer];
+                    positions[listCount++] = 0;
+                }
+            }
+            if (listCount == 1) {
+                for (const LayerEntry& entry : *lists[0]) {
+                    if (!fn(entry.collidable)) return;
+                }
+                return;
+            }
+
+            // Queries rarely name more than a few layers, so a linear pick of the oldest head is enough
+            while (true) {
+                size_t next = listCount;
+                for (size_t i = 0; i < listCount; i++) {
+                    if (positions[i] == lists[i]->size()) continue;
+                    if (next == listCount || (*lists[i])[positions[i]].order < (*lists[next])[positions[next]].order) {
+                        next = i;
+                    }
+                }
+                if (next == listCount) return;
+                if (!fn((*lists[next])[positions[next]++].collidable)) return;
+            }
+        }
+
+        // Layers a query from self should visit
+        CollisionLayerMask QueryMask(ICollidable* self, CollisionLayerMask layers) const {
+            auto it = m_proxyIds.find(self);
+            return it == m_proxyIds.end() ? layers : layers & m_layerMatrix[m_proxies[it->second].layer];
+        }
+
+        void RemoveFromLayer(const Proxy& proxy) {
+            auto& entries = m_layerColliders[proxy.layer];
+            auto position = std::lower_bound(entries.begin(), entries.end(), proxy.order,
+                [](const LayerEntry& entry, uint64_t order) { return entry.order < order; });
+            entries.erase(position);
+            if (entries.empty()) {
+                m_populatedLayers &= ~LayerBit(proxy.layer);
+            }
+        }
+
+        static std::vector<uint32_t>& ScratchBuffer() {
+            static thread_local std::vector<uint32_t> scratch;
+            return scratch;
+        }
+
+        void RefreshBounds(Proxy& proxy) {
+            auto* collider = proxy.collidable->GetCollider();
+            proxy.hasBounds = collider && collider->GetRectangle();
+            if (!proxy.hasBounds) {
+                m_packedBounds.SetEmpty(proxy.packedIndex);
+                return;
+            }
+            proxy.bounds = AABB::FromRectangle(*collider->GetRectangle());
+            proxy.cells = m_spatialHash.GetCellRange(proxy.bounds);
+            m_packedBounds.Set(proxy.packedIndex, *collider->GetRectangle());
+        }
+
+        // Add a proxy with fresh bounds to the active broadphase
+        void InsertProxy(uint32_t id) {
+            Proxy& proxy = m_proxies[id];
+            if (!proxy.hasBounds) return;
+            switch (m_broadphase) {
+                case Broadphase::SpatialHash: m_spatialHash.Insert(id, proxy.cells); break;
+                case Broadphase::AABBTree: proxy.treeNode = m_tree.Insert(proxy.bounds, id); break;
+                case Broadphase::SweepAndPrune:
+                    m_sweepAndPrune.Insert(id, proxy.bounds);
+                    FlushPairEvents();
+                    break;
+                case Broadphase::BruteForce:
+                case Broadphase::PackedScan: break;
+            }
+        }
+
+        // Take a proxy out of the active broadphase (cells = the range it was bucketed with)
+        void RemoveProxy(uint32_t id, const SpatialHash::CellRange& cells) {
+            Proxy& proxy = m_proxies[id];
+            switch (m_broadphase) {
+                case Broadphase::SpatialHash: m_spatialHash.Remove(id, cells); break;
+                case Broadphase::AABBTree: m_tree.Remove(proxy.treeNode); break;
+                case Broadphase::SweepAndPrune:
+                    m_sweepAndPrune.Remove(id);
+                    FlushPairEvents(); // Before the caller resets the proxy
+                    break;
+                case Broadphase::BruteForce:
+                case Broadphase::PackedScan: break;
+            }
+            proxy.treeNode = AABBTree::NullNode;
+        }
+
+        // Turn the sweep-and-prune's id pairs into collidable pairs while the ids are valid
+        void FlushPairEvents() {
+            if (m_recordOverlapEvents) {
+                for (const SweepAndPrune::PairEvent& event : m_sweepAndPrune.GetEvents()) {
+                    const Proxy& a = m_proxies[event.a];
+                    const Proxy& b = m_proxies[event.b];
+                    if (a.order < b.order) {
+                        m_overlapEvents.push_back({a.collidable, b.collidable, event.added});
+                    } else {
+                        m_overlapEvents.push_back({b.collidable, a.collidable, event.added});
+                    }
                 }
             }
+            m_sweepAndPrune.ClearEvents();
+        }
+
+        void RebuildBroadphase() {
+            m_spatialHash.Clear();
+            m_tree.Clear();
+            m_sweepAndPrune.Clear(); // Pairs dropped on a switch away are not reported
+            for (ICollidable* collidable : m_collidables) {
+                uint32_t id = m_proxyIds[collidable];
+                Proxy& proxy = m_proxies[id];
+                proxy.treeNode = AABBTree::NullNode;
+                RefreshBounds(proxy);
+                InsertProxy(id);
+            }
+        }
+
+        // Pairs found from the colliders in m_collidables[begin, end). m_collidables and each
+        // candidate list are in registration order (statics last), so the pairs come out
+        // sorted without a sort. Statics never act as self. Read-only apart from out, so
+        // chunks can run concurrently.
+        void FindContacts(size_t begin, size_t end, std::vector<Contact>& out) {
+            for (size_t i = begin; i < end; i++) {
+                ICollidable* collidable = m_collidables[i];
+                auto* collider = collidable->GetCollider();
+                if (!collider) continue;
+                const Proxy& self = m_proxies[m_proxyIds.find(collidable)->second];
+                uint64_t order = self.order;
+                ForEachCandidate(collidable, *collider, m_layerMatrix[self.layer], [&](ICollidable* other) {
+                    const Proxy& proxy = m_proxies[m_proxyIds.find(other)->second];
+                    if (proxy.order < order) return true; // Found from the other side
+                    auto* otherCollider = other->GetCollider();
+                    if (otherCollider && collider->IsColliding(*otherCollider)) {
+                        out.push_back({order, proxy.order, collidable, other});
+                    }
+                    return true;
+                });
+            }
+        }
+
+        void FindContactsParallel() {
+            size_t count = m_collidables.size();
+            size_t chunkCount = (count + m_pairChunkSize - 1) / m_pairChunkSize;
+            if (m_chunkContacts.size() < chunkCount) {
+                m_chunkContacts.resize(chunkCount);
+            }
+            for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+                m_chunkContacts[chunk].clear(); // Here, since a nested ParallelFor runs as one chunk
+            }
+            m_threadPool->ParallelFor(count, m_pairChunkSize, [this](size_t begin, size_t end, size_t) {
+                FindContacts(begin, end, m_chunkContacts[begin / m_pairChunkSize]);
+            });
+            for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+                m_contacts.insert(m_contacts.end(), m_chunkContacts[chunk].begin(), m_chunkContacts[chunk].end());
+            }
+        }
+
+        static bool IsBefore(const Contact& lhs, const Contact& rhs) {
+            return lhs.orderA < rhs.orderA || (lhs.orderA == rhs.orderA && lhs.orderB < rhs.orderB);
+        }
+
+        void PushContactEvents(const Contact& contact, ContactKind kind) {
+            m_contactEvents.push_back({contact.a, contact.b, kind});
+            m_contactEvents.push_back({contact.b, contact.a, kind});
+        }
+
+        // Callbacks run after the cache is complete so they can query it. A callback may
+        // unregister colliders, so each event re-checks that both sides are still registered.
+        void DispatchContactEvents() {
+            std::vector<ContactEvent> events;
+            events.swap(m_contactEvents);
+            for (const ContactEvent& event : events) {
+                if (!m_proxyIds.count(event.self) || !m_proxyIds.count(event.other)) continue;
+                Entity* other = event.other->AsEntity();
+                switch (event.kind) {
+                    case ContactKind::Enter: event.self->OnCollisionEnter(other); break;
+                    case ContactKind::Stay: event.self->OnCollisionStay(other); break;
+                    case ContactKind::Exit: event.self->OnCollisionExit(other); break;
+                }
+            }
+            events.clear();
+            if (m_contactEvents.empty()) {
+                m_contactEvents.swap(events); // Keep the capacity for next frame
+            }
+        }
+
+        // An unregistered collider's contacts end now; its partners get OnCollisionExit
+        // (it is still alive at this point) and it drops out of their cached lists
+        void DropContacts(ICollidable* collidable) {
+            Entity* entity = collidable->AsEntity();
+            std::vector<ICollidable*> partners;
+            auto removed = std::remove_if(m_contacts.begin(), m_contacts.end(), [&](const Contact& contact) {
+                if (contact.a != collidable && contact.b != collidable) return false;
+                partners.push_back(contact.a == collidable ? contact.b : contact.a);
+                return true;
+            });
+            m_contacts.erase(removed, m_contacts.end());
+
+            for (ICollidable* partner : partners) {
+                auto& contacts = m_proxies[m_proxyIds[partner]].contacts;
+                contacts.erase(std::remove(contacts.begin(), contacts.end(), entity), contacts.end());
+            }
+            for (ICollidable* partner : partners) {
+                if (m_proxyIds.count(partner)) {
+                    partner->OnCollisionExit(entity);
+                }
+            }
+        }
+
+        // Entities found by a query are woken if asleep, so contact reactivates them
+        static Entity* Touch(ICollidable* other) {
+            Entity* entity = other->AsEntity();
+            if (!entity->IsAwake()) {
+                entity->Wake();
+            }
+            return entity;
+        }
+
+        bool DeferOp(ICollidable* collidable, DeferredKind kind, CollisionLayer layer = 0) {
+            if (!m_deferring) return false;
+            int worker = ThreadPool::CurrentWorkerIndex();
+            if (worker < 0 || static_cast<size_t>(worker) >= m_deferredOps.size()) return false;
+            m_deferredOps[worker].push_back({collidable, kind, layer, m_deferredSources[worker]});
+            return true;
         }
     };
 }
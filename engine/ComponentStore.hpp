@@ -0,0 +1,305 @@
+#ifndef COMPONENT_STORE_H
+#define COMPONENT_STORE_H
+#include "engine/EntityHandle.hpp"
+#include "engine/Rectangle.hpp"
+#include "engine/Renderer.hpp"
+#include "engine/Vector2.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Generational handle to a row in a ComponentStore
+    struct ComponentHandle {
+        uint32_t index = EntityHandle::InvalidIndex;
+        uint32_t generation = 0;
+
+        bool IsNull() const { return index == EntityHandle::InvalidIndex; }
+        explicit operator bool() const { return !IsNull(); }
+        bool operator==(const ComponentHandle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+        bool operator!=(const ComponentHandle& rhs) const { return !(*this == rhs); }
+    };
+
+    // Which optional components a row has (every row has a transform)
+    enum ComponentFlags : uint8_t {
+        ComponentVelocity = 1 << 0,
+        ComponentCollider = 1 << 1,
+        ComponentRender   = 1 << 2
+    };
+
+    // Data-oriented storage for simple objects: one row per object, one dense array per field.
+    // Systems walk the arrays linearly instead of making a virtual Update call per object.
+    // Rows can stand alone or be owned by an Entity (see EntityManager::AddComponents).
+    // Removal swaps the last row into the hole, so row order is not stable.
+    class ComponentStore {
+    private:
+        struct Slot {
+            uint32_t row = 0;
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        // Transform
+        std::vector<float> m_posX;
+        std::vector<float> m_posY;
+        // Velocity (zero when the row has none, so integration needs no branch)
+        std::vector<float> m_velX;
+        std::vector<float> m_velY;
+        // Collider bounds (size - position comes from the transform)
+        std::vector<float> m_colliderW;
+        std::vector<float> m_colliderH;
+        // Render info
+        std::vector<int> m_renderW;
+        std::vector<int> m_renderH;
+        std::vector<Uint32> m_renderColor; // Packed RGBA
+
+        std::vector<uint8_t> m_flags;
+        std::vector<EntityHandle> m_owners;
+        std::vector<uint32_t> m_rowSlots;  // Row -> slot, to patch the slot map on swap-remove
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+
+    public:
+        ComponentStore() = default;
+
+        // Create a row with a transform component
+        ComponentHandle Create(Vector2f position, EntityHandle owner = EntityHandle()) {
+            uint32_t index;
+            if (!m_freeSlots.empty()) {
+                index = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            } else {
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+
+            Slot& slot = m_slots[index];
+            slot.row = static_cast<uint32_t>(m_posX.size());
+            slot.alive = true;
+
+            m_posX.push_back(position.GetX());
+            m_posY.push_back(position.GetY());
+            m_velX.push_back(0.0f);
+            m_velY.push_back(0.0f);
+            m_colliderW.push_back(0.0f);
+            m_colliderH.push_back(0.0f);
+            m_renderW.push_back(0);
+            m_renderH.push_back(0);
+            m_renderColor.push_back(0);
+            m_flags.push_back(0);
+            m_owners.push_back(owner);
+            m_rowSlots.push_back(index);
+
+            ComponentHandle handle;
+            handle.index = index;
+            handle.generation = slot.generation;
+            return handle;
+        }
+
+        // Remove a row - O(1), the last row is moved into its place
+        void Destroy(ComponentHandle handle) {
+            if (!IsValid(handle)) return;
+            Slot& slot = m_slots[handle.index];
+            size_t row = slot.row;
+            size_t last = m_posX.size() - 1;
+
+            if (row != last) {
+                m_posX[row] = m_posX[last];
+                m_posY[row] = m_posY[last];
+                m_velX[row] = m_velX[last];
+                m_velY[row] = m_velY[last];
+                m_colliderW[row] = m_colliderW[last];
+                m_colliderH[row] = m_colliderH[last];
+                m_renderW[row] = m_renderW[last];
+                m_renderH[row] = m_renderH[last];
+                m_renderColor[row] = m_renderColor[last];
+                m_flags[row] = m_flags[last];
+                m_owners[row] = m_owners[last];
+                m_rowSlots[row] = m_rowSlots[last];
+                m_slots[m_rowSlots[row]].row = static_cast<uint32_t>(row);
+            }
+
+            m_posX.pop_back();
+            m_posY.pop_back();
+            m_velX.pop_back();
+            m_velY.pop_back();
+            m_colliderW.pop_back();
+            m_colliderH.pop_back();
+            m_renderW.pop_back();
+            m_renderH.pop_back();
+            m_renderColor.pop_back();
+            m_flags.pop_back();
+            m_owners.pop_back();
+            m_rowSlots.pop_back();
+
+            slot.alive = false;
+            slot.generation++;
+            m_freeSlots.push_back(handle.index);
+        }
+
+        bool IsValid(ComponentHandle handle) const {
+            return handle.index < m_slots.size() &&
+                   m_slots[handle.index].alive &&
+                   m_slots[handle.index].generation == handle.generation;
+        }
+
+        // Accessors ignore stale or null handles: getters return a default value, setters do nothing
+
+        // Transform
+        Vector2f GetPosition(ComponentHandle handle) const {
+            if (!IsValid(handle)) return Vector2f();
+            size_t row = m_slots[handle.index].row;
+            return Vector2f(m_posX[row], m_posY[row]);
+        }
+
+        void SetPosition(ComponentHandle handle, Vector2f position) {
+            if (!IsValid(handle)) return;
+            size_t row = m_slots[handle.index].row;
+            m_posX[row] = position.GetX();
+            m_posY[row] = position.GetY();
+        }
+
+        // Velocity
+        void SetVelocity(ComponentHandle handle, Vector2f velocity) {
+            if (!IsValid(handle)) return;
+            size_t row = m_slots[handle.index].row;
+            m_velX[row] = velocity.GetX();
+            m_velY[row] = velocity.GetY();
+            m_flags[row] |= ComponentVelocity;
+        }
+
+        Vector2f GetVelocity(ComponentHandle handle) const {
+            if (!IsValid(handle)) return Vector2f();
+            size_t row = m_slots[handle.index].row;
+            return Vector2f(m_velX[row], m_velY[row]);
+        }
+
+        // Collider bounds
+        void SetCollider(ComponentHandle handle, Vector2f size) {
+            if (!IsValid(handle)) return;
+            size_t row = m_slots[handle.index].row;
+            m_colliderW[row] = size.GetX();
+            m_colliderH[row] = size.GetY();
+            m_flags[row] |= ComponentCollider;
+        }
+
+        Rectangle<float> GetColliderBounds(ComponentHandle handle) const {
+            if (!IsValid(handle)) return Rectangle<float>();
+            size_t row = m_slots[handle.index].row;
+            return Rectangle<float>(Vector2f(m_posX[row], m_posY[row]),
+                                    Vector2f(m_colliderW[row], m_colliderH[row]));
+        }
+
+        // Render info (drawn as a filled rectangle)
+        void SetRenderInfo(ComponentHandle handle, int width, int height, const Color& color) {
+            if (!IsValid(handle)) return;
+            size_t row = m_slots[handle.index].row;
+            m_renderW[row] = width;
+            m_renderH[row] = height;
+            m_renderColor[row] = PackColor(color);
+            m_flags[row] |= ComponentRender;
+        }
+
+        bool Has(ComponentHandle handle, ComponentFlags component) const {
+            return IsValid(handle) && (m_flags[m_slots[handle.index].row] & component) != 0;
+        }
+
+        void RemoveComponent(ComponentHandle handle, ComponentFlags component) {
+            if (!IsValid(handle)) return;
+            size_t row = m_slots[handle.index].row;
+            m_flags[row] &= static_cast<uint8_t>(~component);
+            if (component == ComponentVelocity) {
+                m_velX[row] = 0.0f;
+                m_velY[row] = 0.0f;
+            }
+        }
+
+        EntityHandle GetOwner(ComponentHandle handle) const {
+            if (!IsValid(handle)) return EntityHandle();
+            return m_owners[m_slots[handle.index].row];
+        }
+
+        size_t Count() const { return m_posX.size(); }
+
+        void Clear() {
+            for (uint32_t i = 0; i < m_slots.size(); i++) {
+                if (m_slots[i].alive) {
+                    m_slots[i].alive = false;
+                    m_slots[i].generation++;
+                    m_freeSlots.push_back(i);
+                }
+            }
+            m_posX.clear();
+            m_posY.clear();
+            m_velX.clear();
+            m_velY.clear();
+            m_colliderW.clear();
+            m_colliderH.clear();
+            m_renderW.clear();
+            m_renderH.clear();
+            m_renderColor.clear();
+            m_flags.clear();
+            m_owners.clear();
+            m_rowSlots.clear();
+        }
+
+        // Movement system: position += velocity * deltaTime over every row
+        void Integrate(float deltaTime) {
+            float* posX = m_posX.data();
+            float* posY = m_posY.data();
+            const float* velX = m_velX.data();
+            const float* velY = m_velY.data();
+            size_t count = m_posX.size();
+            for (size_t i = 0; i < count; i++) {
+                posX[i] += velX[i] * deltaTime;
+                posY[i] += velY[i] * deltaTime;
+            }
+        }
+
+        // Render system: draw every row with render info as a filled rectangle
+        void Draw(Renderer& renderer) const {
+            Uint32 currentColor = 0;
+            bool colorSet = false;
+            for (size_t i = 0; i < m_flags.size(); i++) {
+                if (!(m_flags[i] & ComponentRender)) continue;
+                if (!colorSet || m_renderColor[i] != currentColor) {
+                    currentColor = m_renderColor[i];
+                    colorSet = true;
+                    renderer.SetColor(UnpackColor(currentColor));
+                }
+                renderer.DrawFilledRect(m_posX[i], m_posY[i], m_renderW[i], m_renderH[i]);
+            }
+        }
+
+        // Call fn(ownerHandle, x, y) for every row owned by an entity - fn may write the position
+        template<typename Fn>
+        void ForEachOwned(Fn&& fn) {
+            for (size_t i = 0; i < m_owners.size(); i++) {
+                if (!m_owners[i].IsNull()) {
+                    fn(m_owners[i], m_posX[i], m_posY[i]);
+                }
+            }
+        }
+
+        // Raw column access for custom systems (valid until the next Create/Destroy)
+        float* GetPositionsX() { return m_posX.data(); }
+        float* GetPositionsY() { return m_posY.data(); }
+        float* GetVelocitiesX() { return m_velX.data(); }
+        float* GetVelocitiesY() { return m_velY.data(); }
+        const float* GetCollidersW() const { return m_colliderW.data(); }
+        const float* GetCollidersH() const { return m_colliderH.data(); }
+        const uint8_t* GetFlags() const { return m_flags.data(); }
+
+    private:
+        static Uint32 PackColor(const Color& color) {
+            return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+                   (static_cast<Uint32>(color.b) << 8) | static_cast<Uint32>(color.a);
+        }
+
+        static Color UnpackColor(Uint32 packed) {
+            return Color(static_cast<Uint8>(packed >> 24), static_cast<Uint8>(packed >> 16),
+                         static_cast<Uint8>(packed >> 8), static_cast<Uint8>(packed));
+        }
+    };
+}
+#endif
@@ -0,0 +1,176 @@
+#ifndef DRAW_QUEUE_H
+#define DRAW_QUEUE_H
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+    // Draw calls recorded during a sorted pass, replayed in key order. The 64-bit key is,
+    // from the most significant bits down:
+    //
+    //   layer (16) | y (20) | material (24) | blend mode (4)
+    //
+    // so layers always draw in order, Y-sorted layers draw bottom edge top to bottom, and
+    // everything left sharing a layer (and Y) is grouped by material: a texture, or the
+    // draw color for untextured shapes. Materials are numbered in the order they were first
+    // used in the pass, and the sort is stable, so draws with equal keys keep the order
+    // they were recorded in.
+    class DrawQueue {
+    public:
+        enum class CommandType : uint8_t { Sprite, FilledRect, Rect, Line, Point };
+
+        // Screen-space draw. Lines keep their end points in dest (x, y) -> (w, h).
+        struct Command {
+            CommandType type = CommandType::Sprite;
+            SDL_RendererFlip flip = SDL_FLIP_NONE;
+            bool hasSource = false;
+            SDL_Texture* texture = nullptr;
+            SDL_Rect source = { 0, 0, 0, 0 };
+            SDL_Rect dest = { 0, 0, 0, 0 };
+            double angle = 0.0;
+            SDL_Color color = { 255, 255, 255, 255 }; // Tint for sprites, draw color for shapes
+            SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+        };
+
+        static constexpr int LayerShift = 48;
+        static constexpr int YShift = 28;
+        static constexpr int MaterialShift = 4;
+        static constexpr uint64_t YMask = (1ull << 20) - 1;
+        static constexpr uint64_t MaterialMask = (1ull << 24) - 1;
+
+    private:
+        struct Entry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        std::vector<Command> m_commands;
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_scratch;
+        std::unordered_map<uint64_t, uint32_t> m_materials;
+        uint64_t m_lastMaterial = 0;
+        uint32_t m_lastMaterialId = 0;
+        bool m_sorted = false;
+
+    public:
+        // Drop everything recorded (buffers keep their capacity)
+        void Clear() {
+            m_commands.clear();
+            m_entries.clear();
+            m_materials.clear();
+            m_lastMaterialId = 0;
+            m_sorted = false;
+        }
+
+        // Record a command. sortY is the screen y the command sorts by when ySort is set
+        // (normally its bottom edge); it's ignored otherwise.
+        void Add(const Command& command, int layer, bool ySort, float sortY) {
+            uint32_t material = MaterialId(command);
+            int y = ySort ? static_cast<int>(std::floor(sortY)) : 0;
+            m_entries.push_back({ MakeKey(layer, y, material, command.blend),
+                                  static_cast<uint32_t>(m_commands.size()) });
+            m_commands.push_back(command);
+            m_sorted = false;
+        }
+
+        // Key for a command; y is only meaningful within a Y-sorted layer
+        static uint64_t MakeKey(int layer, int y, uint32_t material, SDL_BlendMode blend) {
+            uint64_t layerBits = static_cast<uint64_t>(std::clamp(layer, -32768, 32767) + 32768);
+            uint64_t yBits = static_cast<uint64_t>(std::clamp(y + (1 << 19), 0, static_cast<int>(YMask)));
+            uint64_t materialBits = std::min<uint64_t>(material, MaterialMask);
+            return (layerBits << LayerShift) | (yBits << YShift) |
+                   (materialBits << MaterialShift) | BlendBits(blend);
+        }
+
+        // Order commands by key. LSD radix sort, one byte per pass, skipping bytes every
+        // key has in common (in a typical frame most of the key is constant).
+        void Sort() {
+            if (m_sorted) return;
+            m_sorted = true;
+            size_t count = m_entries.size();
+            if (count < 2) return;
+
+            size_t histograms[8][256] = {};
+            for (const Entry& entry : m_entries) {
+                for (int byte = 0; byte < 8; byte++) {
+                    histograms[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+                }
+            }
+
+            m_scratch.resize(count);
+            for (int byte = 0; byte < 8; byte++) {
+                size_t* histogram = histograms[byte];
+                if (histogram[(m_entries[0].key >> (byte * 8)) & 0xFF] == count) continue;
+
+                size_t offset = 0;
+                for (int bucket = 0; bucket < 256; bucket++) {
+                    size_t bucketCount = histogram[bucket];
+                    histogram[bucket] = offset;
+                    offset += bucketCount;
+                }
+                for (const Entry& entry : m_entries) {
+                    m_scratch[histogram[(entry.key >> (byte * 8)) & 0xFF]++] = entry;
+                }
+                m_entries.swap(m_scratch);
+            }
+        }
+
+        // Call fn(command) in key order (Sort first), or in recording order before sorting
+        template<typename Fn>
+        void ForEach(Fn&& fn) const {
+            for (const Entry& entry : m_entries) {
+                fn(m_commands[entry.index]);
+            }
+        }
+
+        // Times consecutive commands change texture (untextured shapes count as no texture)
+        // in the current order - compare before and after Sort to see what sorting saved
+        size_t CountTextureSwitches() const {
+            size_t switches = 0;
+            for (size_t i = 1; i < m_entries.size(); i++) {
+                if (m_commands[m_entries[i].index].texture != m_commands[m_entries[i - 1].index].texture) {
+                    switches++;
+                }
+            }
+            return switches;
+        }
+
+        size_t Count() const { return m_commands.size(); }
+        bool IsEmpty() const { return m_commands.empty(); }
+
+    private:
+        // Textures are keyed by address (always even); shape colors by packed RGBA, tagged odd
+        uint32_t MaterialId(const Command& command) {
+            uint64_t material;
+            if (command.texture) {
+                material = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(command.texture));
+            } else {
+                uint32_t rgba = (static_cast<uint32_t>(command.color.r) << 24) |
+                                (static_cast<uint32_t>(command.color.g) << 16) |
+                                (static_cast<uint32_t>(command.color.b) << 8) | command.color.a;
+                material = (static_cast<uint64_t>(rgba) << 1) | 1u;
+            }
+            // Runs of the same material are the common case - skip the map for them
+            if (m_lastMaterialId != 0 && material == m_lastMaterial) return m_lastMaterialId;
+
+            auto inserted = m_materials.emplace(material, static_cast<uint32_t>(m_materials.size() + 1));
+            m_lastMaterial = material;
+            m_lastMaterialId = inserted.first->second;
+            return m_lastMaterialId;
+        }
+
+        static uint64_t BlendBits(SDL_BlendMode blend) {
+            switch (blend) {
+                case SDL_BLENDMODE_NONE: return 0;
+                case SDL_BLENDMODE_BLEND: return 1;
+                case SDL_BLENDMODE_ADD: return 2;
+                case SDL_BLENDMODE_MOD: return 3;
+                default: return 4;
+            }
+        }
+    };
+}
+#endif
@@ -2,6 +2,8 @@
 #define ENTITY_H
 #include "engine/Renderer.hpp"
 #include "engine/Vector2.hpp"
+#include "engine/EntityHandle.hpp"
+#include "engine/TagRegistry.hpp"
 #include <initializer_list>
 #include <string>
 #include <set>
@@ -13,12 +15,36 @@ namespace Engine {
     class SceneManager;
     class GameMeta;
     class AudioManager;
+    class Entity;
+
+    enum class EntityState : uint8_t {
+        Active,   // Updated and drawn
+        Sleeping, // Drawn but not updated (see Entity::Sleep)
+        Dormant   // Neither - outside the EntityManager's activation region
+    };
+
+    // Implemented by whatever owns an entity, to keep its indexes in sync when
+    // the entity changes properties they are keyed on
+    class EntityOwner {
+    public:
+        virtual ~EntityOwner() = default;
+        virtual void OnRenderLayerChanged(Entity* entity) = 0;
+        virtual void OnStateRequested(Entity* entity, EntityState state) = 0;
+        virtual void OnAutoSleepChanged(Entity* entity) = 0;
+    };
 
     class Entity {
+        friend class EntityManager; // Assigns the handle when the entity is added
+
     private:
         Vector2f m_position = Vector2f(0.0f);
-        std::set<std::string> m_tags;
+        TagMask m_tagMask = 0;
         int m_nRenderLayer = 0;
+        EntityHandle m_handle;
+        EntityOwner* m_owner = nullptr;
+        EntityState m_state = EntityState::Active;
+        bool m_bThreadSafe = false;
+        bool m_bAutoSleep = false;
 
     protected:
         // Dependencies - set at init time, used throughout entity lifetime
@@ -33,16 +59,63 @@ namespace Engine {
         Entity() = default;
         virtual ~Entity() = default;
         Entity(Vector2f position) : m_position(position) {}
-        Entity(Vector2f position, std::initializer_list<std::string> tags) : m_position(position), m_tags(tags) {}
+        Entity(Vector2f position, std::initializer_list<std::string> tags) : m_position(position) {
+            for (const std::string& tag : tags) {
+                m_tagMask |= TagRegistry::ToMask(TagRegistry::Intern(tag));
+            }
+        }
 
         // Getters
         Vector2f GetPosition() const { return m_position; }
-        const std::set<std::string>& GetTags() const { return m_tags; }
+        // Tag names, built from the mask on each call - prefer HasTag in per-frame code
+        std::set<std::string> GetTags() const {
+            std::set<std::string> tags;
+            TagRegistry::ForEachTag(m_tagMask, [&tags](TagId tag) {
+                tags.insert(TagRegistry::GetName(tag));
+            });
+            return tags;
+        }
+        TagMask GetTagMask() const { return m_tagMask; }
+
+        // Tag membership - the TagId overloads are a single AND
+        bool HasTag(TagId tag) const { return (m_tagMask & TagRegistry::ToMask(tag)) != 0; }
+        bool HasTag(const std::string& tag) const { return HasTag(TagRegistry::Find(tag)); }
+        bool HasAnyTag(TagMask mask) const { return (m_tagMask & mask) != 0; }
+        bool HasAllTags(TagMask mask) const { return (m_tagMask & mask) == mask; }
         int GetRenderLayer() const { return m_nRenderLayer; }
+        EntityHandle GetHandle() const { return m_handle; } // Null until owned by an EntityManager
 
         // Setters for core properties
         void SetPosition(Vector2f position) { m_position = position; }
-        void SetRenderLayer(int renderLayer) { m_nRenderLayer = renderLayer; }
+        void SetRenderLayer(int renderLayer) {
+            if (renderLayer == m_nRenderLayer) return;
+            m_nRenderLayer = renderLayer;
+            if (m_owner) m_owner->OnRenderLayerChanged(this); // Moves it to the new draw bucket
+        }
+
+        // Thread-safe entities may be updated on worker threads when the EntityManager has a
+        // thread pool. Their Update must only write their own state; structural changes
+        // (Create, Remove, collision Register/Unregister) are deferred to a sync point.
+        void SetThreadSafe(bool threadSafe) { m_bThreadSafe = threadSafe; }
+        bool IsThreadSafe() const { return m_bThreadSafe; }
+
+        // Sleeping entities are skipped by EntityManager::UpdateAll but still drawn - use for
+        // static scenery. They wake on Wake(), or when a collision query touches them.
+        // Called on an owned entity, the change is applied by the manager (deferred to the
+        // sync point during a parallel update).
+        void Sleep() { RequestState(EntityState::Sleeping); }
+        void Wake() { RequestState(EntityState::Active); }
+        bool IsAwake() const { return m_state == EntityState::Active; }
+        EntityState GetState() const { return m_state; }
+
+        // Auto-sleep entities go dormant (no Update, no Draw) while their position is outside
+        // the EntityManager's activation region, and wake when they enter it
+        void SetAutoSleep(bool autoSleep) {
+            if (autoSleep == m_bAutoSleep) return;
+            m_bAutoSleep = autoSleep;
+            if (m_owner) m_owner->OnAutoSleepChanged(this);
+        }
+        bool GetAutoSleep() const { return m_bAutoSleep; }
 
         // Dependency injection - call these before/during Init
         void SetRenderer(Renderer* renderer) { m_renderer = renderer; }
@@ -56,6 +129,16 @@ namespace Engine {
         virtual void Init() {}
         virtual void Update(float deltaTime) { (void)deltaTime; }
         virtual void Draw() {}
+
+    private:
+        void RequestState(EntityState state) {
+            if (state == m_state) return;
+            if (m_owner) {
+                m_owner->OnStateRequested(this, state);
+            } else {
+                m_state = state;
+            }
+        }
     };
 }
 #endif
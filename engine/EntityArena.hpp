@@ -0,0 +1,164 @@
+#ifndef ENTITY_ARENA_H
+#define ENTITY_ARENA_H
+#include "engine/Entity.hpp"
+#include "engine/TypeId.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Engine {
+    // Fixed-size block allocator for one entity type.
+    // Blocks are carved out of large chunks in order, so entities of the same type
+    // sit next to each other in memory. Freed blocks go on a free list for reuse.
+    class EntitySlab {
+    private:
+        static constexpr size_t ChunkBytes = 16 * 1024;
+        static constexpr size_t MinBlocksPerChunk = 8;
+
+        struct ChunkDeleter {
+            size_t alignment;
+            void operator()(std::byte* chunk) const {
+                ::operator delete(chunk, std::align_val_t(alignment));
+            }
+        };
+        using Chunk = std::unique_ptr<std::byte[], ChunkDeleter>;
+
+        size_t m_blockSize;
+        size_t m_alignment;
+        size_t m_blocksPerChunk;
+        std::vector<Chunk> m_chunks;
+        std::vector<void*> m_freeBlocks;
+        size_t m_currentChunk = 0;   // Chunk being bump-allocated from
+        size_t m_nextBlock = 0;      // Next unused block in that chunk
+        size_t m_liveBlocks = 0;
+
+    public:
+        EntitySlab(size_t size, size_t alignment)
+            : m_blockSize((size + alignment - 1) / alignment * alignment),
+              m_alignment(alignment),
+              m_blocksPerChunk(std::max(MinBlocksPerChunk, ChunkBytes / m_blockSize)) {}
+
+        void* Allocate() {
+            m_liveBlocks++;
+            if (!m_freeBlocks.empty()) {
+                void* block = m_freeBlocks.back();
+                m_freeBlocks.pop_back();
+                return block;
+            }
+
+            if (m_nextBlock == m_blocksPerChunk) {
+                m_currentChunk++;
+                m_nextBlock = 0;
+            }
+            if (m_currentChunk == m_chunks.size()) {
+                auto* memory = static_cast<std::byte*>(
+                    ::operator new(m_blockSize * m_blocksPerChunk, std::align_val_t(m_alignment)));
+                m_chunks.emplace_back(memory, ChunkDeleter{m_alignment});
+            }
+            return m_chunks[m_currentChunk].get() + m_blockSize * m_nextBlock++;
+        }
+
+        void Free(void* block) {
+            m_liveBlocks--;
+            m_freeBlocks.push_back(block);
+        }
+
+        // Forget every block at once, keeping the chunks for reuse.
+        // Objects in the slab must already have been destroyed.
+        void Reset() {
+            m_freeBlocks.clear();
+            m_currentChunk = 0;
+            m_nextBlock = 0;
+            m_liveBlocks = 0;
+        }
+
+        // Reset and hand the chunk memory back to the system
+        void Release() {
+            Reset();
+            m_chunks.clear();
+        }
+
+        size_t GetLiveCount() const { return m_liveBlocks; }
+        size_t GetChunkCount() const { return m_chunks.size(); }
+        size_t GetBlockSize() const { return m_blockSize; }
+    };
+
+    // Deleter for entities owned by an EntityManager - returns arena blocks to their slab,
+    // falls back to plain delete for heap-allocated entities
+    struct EntityDeleter {
+        EntitySlab* slab = nullptr;
+
+        void operator()(Entity* entity) const {
+            if (slab) {
+                entity->~Entity();
+                slab->Free(entity);
+            } else {
+                delete entity;
+            }
+        }
+    };
+
+    using EntityPtr = std::unique_ptr<Entity, EntityDeleter>;
+
+    // One slab per concrete entity type
+    class EntityArena {
+    private:
+        std::vector<std::unique_ptr<EntitySlab>> m_slabs; // Indexed by TypeId
+
+    public:
+        EntityArena() = default;
+
+        // Construct a T in its type's slab
+        template<typename T, typename... Args>
+        EntityPtr Create(Args&&... args) {
+            static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity");
+            EntitySlab& slab = GetSlab<T>();
+            void* block = slab.Allocate();
+            T* entity = nullptr;
+            try {
+                entity = new (block) T(std::forward<Args>(args)...);
+            } catch (...) {
+                slab.Free(block);
+                throw;
+            }
+            return EntityPtr(entity, EntityDeleter{&slab});
+        }
+
+        template<typename T>
+        EntitySlab& GetSlab() {
+            TypeId id = GetTypeId<T>();
+            if (id >= m_slabs.size()) {
+                m_slabs.resize(id + 1);
+            }
+            if (!m_slabs[id]) {
+                m_slabs[id] = std::make_unique<EntitySlab>(sizeof(T), alignof(T));
+            }
+            return *m_slabs[id];
+        }
+
+        // Rewind every slab in one go (entities must already be destroyed)
+        void Reset() {
+            for (auto& slab : m_slabs) {
+                if (slab) slab->Reset();
+            }
+        }
+
+        // Free all chunk memory
+        void Release() {
+            for (auto& slab : m_slabs) {
+                if (slab) slab->Release();
+            }
+        }
+
+        size_t GetLiveCount() const {
+            size_t count = 0;
+            for (const auto& slab : m_slabs) {
+                if (slab) count += slab->GetLiveCount();
+            }
+            return count;
+        }
+    };
+}
+#endif
@@ -0,0 +1,135 @@
+#ifndef ENTITY_COMMAND_BUFFER_H
+#define ENTITY_COMMAND_BUFFER_H
+#include "engine/Entity.hpp"
+#include "engine/EntityArena.hpp"
+#include "engine/EntityHandle.hpp"
+#include "engine/TagRegistry.hpp"
+#include "engine/TypeId.hpp"
+#include <memory>
+#include <vector>
+
+namespace Engine {
+    // Records structural changes (create, remove, tag, render layer and sleep state changes) so they can
+    // be applied to an EntityManager in one batch via EntityManager::Playback.
+    // EntityManager records into its own buffers automatically while UpdateAll is running.
+    class EntityCommandBuffer {
+        friend class EntityManager;
+
+    private:
+        struct CreateCommand {
+            EntityPtr entity;
+            TypeId typeId;
+            size_t source; // Recording order key - commands are played back sorted by it
+        };
+
+        struct RemoveCommand {
+            EntityHandle handle;
+            Entity* entity; // Set instead of handle for entities still waiting in a buffer
+        };
+
+        struct TagCommand {
+            Entity* entity;
+            TagId tag;
+            bool add;
+            size_t source;
+        };
+
+        struct LayerCommand {
+            Entity* entity;
+            int renderLayer;
+            size_t source;
+        };
+
+        struct StateCommand {
+            Entity* entity;
+            EntityState state;
+            size_t source;
+        };
+
+        static constexpr TypeId NoTypeId = 0xFFFFFFFFu;
+
+        std::vector<CreateCommand> m_creates;
+        std::vector<RemoveCommand> m_removes;
+        std::vector<TagCommand> m_tagChanges;
+        std::vector<LayerCommand> m_layerChanges;
+        std::vector<StateCommand> m_stateChanges;
+        size_t m_source = 0;
+
+    public:
+        EntityCommandBuffer() = default;
+
+        // Construct now, add to the manager on playback (the handle is null until then)
+        template<typename T, typename... Args>
+        T* Create(Args&&... args) {
+            static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity");
+            T* ptr = new T(std::forward<Args>(args)...);
+            m_creates.push_back({EntityPtr(ptr, EntityDeleter{}), GetTypeId<T>(), m_source});
+            return ptr;
+        }
+
+        Entity* Add(std::unique_ptr<Entity> entity) {
+            Entity* ptr = entity.release();
+            m_creates.push_back({EntityPtr(ptr, EntityDeleter{}), NoTypeId, m_source});
+            return ptr;
+        }
+
+        void Remove(EntityHandle handle) {
+            m_removes.push_back({handle, nullptr});
+        }
+
+        void Remove(Entity* entity) {
+            if (!entity) return;
+            if (entity->GetHandle().IsNull()) {
+                m_removes.push_back({EntityHandle(), entity});
+            } else {
+                m_removes.push_back({entity->GetHandle(), nullptr});
+            }
+        }
+
+        void AddTag(Entity* entity, TagId tag) {
+            if (entity && tag != TagRegistry::InvalidTag) m_tagChanges.push_back({entity, tag, true, m_source});
+        }
+
+        void RemoveTag(Entity* entity, TagId tag) {
+            if (entity && tag != TagRegistry::InvalidTag) m_tagChanges.push_back({entity, tag, false, m_source});
+        }
+
+        void SetRenderLayer(Entity* entity, int renderLayer) {
+            if (entity) m_layerChanges.push_back({entity, renderLayer, m_source});
+        }
+
+        void Sleep(Entity* entity) {
+            if (entity) m_stateChanges.push_back({entity, EntityState::Sleeping, m_source});
+        }
+
+        void Wake(Entity* entity) {
+            if (entity) m_stateChanges.push_back({entity, EntityState::Active, m_source});
+        }
+
+        // Ordering key stamped on subsequent creates (EntityManager uses the updating entity's index)
+        void SetSource(size_t source) { m_source = source; }
+
+        bool IsEmpty() const {
+            return m_creates.empty() && m_removes.empty() && m_tagChanges.empty() &&
+                   m_layerChanges.empty() && m_stateChanges.empty();
+        }
+
+        size_t GetCreateCount() const { return m_creates.size(); }
+
+        // Drop every recorded command (pending creates are destroyed)
+        void Clear() {
+            m_creates.clear();
+            m_removes.clear();
+            m_tagChanges.clear();
+            m_layerChanges.clear();
+            m_stateChanges.clear();
+            m_source = 0;
+        }
+
+    private:
+        void PushCreate(EntityPtr entity, TypeId typeId) {
+            m_creates.push_back({std::move(entity), typeId, m_source});
+        }
+    };
+}
+#endif
@@ -0,0 +1,42 @@
+#ifndef ENTITY_HANDLE_H
+#define ENTITY_HANDLE_H
+#include <cstdint>
+#include <functional>
+
+namespace Engine {
+    // Generational handle to an entity owned by an EntityManager.
+    // The index selects a slot in the manager, the generation is bumped every time
+    // that slot is freed - so a handle to a removed entity resolves to nullptr
+    // instead of dangling, even after the slot has been reused.
+    struct EntityHandle {
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        uint32_t index = InvalidIndex;
+        uint32_t generation = 0;
+
+        EntityHandle() = default;
+        EntityHandle(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+        // True if the handle was ever issued (says nothing about whether the entity is still alive)
+        bool IsNull() const { return index == InvalidIndex; }
+        explicit operator bool() const { return !IsNull(); }
+
+        bool operator==(const EntityHandle& rhs) const {
+            return index == rhs.index && generation == rhs.generation;
+        }
+
+        bool operator!=(const EntityHandle& rhs) const {
+            return !(*this == rhs);
+        }
+    };
+}
+
+// Allow EntityHandle as a key in unordered containers
+namespace std {
+    template<> struct hash<Engine::EntityHandle> {
+        size_t operator()(const Engine::EntityHandle& handle) const {
+            return hash<uint64_t>()((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+        }
+    };
+}
+#endif
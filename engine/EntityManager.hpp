@@ -1,83 +1,283 @@
 #ifndef ENTITY_MANAGER_H
 #define ENTITY_MANAGER_H
+#include "engine/Camera.hpp"
+#include "engine/CollisionManager.hpp"
+#include "engine/ComponentStore.hpp"
 #include "engine/Entity.hpp"
+#include "engine/EntityArena.hpp"
+#include "engine/EntityCommandBuffer.hpp"
+#include "engine/EntityHandle.hpp"
 #include "engine/Renderer.hpp"
+#include "engine/TagRegistry.hpp"
+#include "engine/ThreadPool.hpp"
+#include "engine/TypeId.hpp"
+#include <array>
 #include <vector>
 #include <memory>
 #include <algorithm>
-#include <functional>
-#include <unordered_map>
+#include <map>
 
 namespace Engine {
     // Forward declarations
-    class CollisionManager;
     class GameMeta;
     class AudioManager;
-    class EntityManager {
+    class EntityManager : private EntityOwner {
     private:
-        std::vector<std::unique_ptr<Entity>> m_entities;
-        std::unordered_map<std::string, std::vector<Entity*>> m_tagIndex;
-        std::vector<Entity*> m_pendingRemoval;
-        bool m_needsSort = false;
+        static constexpr TypeId NoTypeId = 0xFFFFFFFFu;
+
+        // Slot map entry - handles index into m_slots, slots point back into m_entities
+        struct Slot {
+            Entity* entity = nullptr;
+            uint32_t generation = 0;
+            uint32_t denseIndex = 0;
+            TypeId typeId = NoTypeId;
+            ComponentHandle components;
+            int drawLayer = 0;        // Layer bucket currently holding the entity
+            uint32_t drawIndex = 0;   // Position within that bucket
+            uint32_t activeIndex = EntityHandle::InvalidIndex; // Position in m_active, if listed
+            bool pendingRemoval = false;
+            bool autoSleep = false;   // Listed in m_autoSleepers
+        };
+
+        // Draw order for one render layer, in insertion order. Removal leaves a nullptr
+        // hole that is compacted away lazily, so both insert and remove are O(1).
+        struct LayerBucket {
+            std::vector<Entity*> entities;
+            size_t holes = 0;
+        };
+
+        // Declared before m_entities so it outlives the entities allocated from it
+        EntityArena m_arena;
+        bool m_useArena = false;
+
+        std::vector<EntityPtr> m_entities; // Insertion order - this is the update order
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::array<std::vector<Entity*>, TagRegistry::MaxTags> m_tagIndex; // Indexed by TagId
+        std::vector<std::vector<Entity*>> m_typeIndex; // Indexed by TypeId, Create<T> only
+        std::vector<EntityHandle> m_pendingRemoval;
+        std::vector<EntityHandle> m_removalBatch;
+        std::vector<std::vector<Entity*>*> m_touchedBuckets;
+        std::vector<EntityPtr> m_graveyard;
+        ComponentStore m_components;
+        std::map<int, LayerBucket> m_layers; // Draw order, lowest layer first
+        std::vector<EntityHandle> m_deferredLayerMoves;
+        bool m_drawing = false;
+
+        // Entities UpdateAll visits, in insertion order. Sleeping leaves a nullptr hole;
+        // waking out of order or too many holes rebuild the list at the next UpdateAll.
+        std::vector<Entity*> m_active;
+        size_t m_activeHoles = 0;
+        bool m_activeDirty = false;
+        size_t m_sleepingCount = 0;
+        size_t m_dormantCount = 0;
+
+        // Auto-sleep entities are checked against the camera view grown by the margin
+        std::vector<EntityHandle> m_autoSleepers;
+        const Camera* m_activationCamera = nullptr;
+        float m_activationMargin = 0.0f;
+
+        // Structural changes made while UpdateAll runs are recorded here and played back in
+        // one batch - one buffer for the updating thread plus one per pool worker
+        EntityCommandBuffer m_commands;
+        std::vector<EntityCommandBuffer> m_workerBuffers;
+        std::vector<EntityCommandBuffer::CreateCommand*> m_createScratch;
+        std::vector<EntityCommandBuffer::TagCommand*> m_tagScratch;
+        std::vector<EntityCommandBuffer::LayerCommand*> m_layerScratch;
+        std::vector<EntityCommandBuffer::StateCommand*> m_stateScratch;
+        bool m_updating = false;
+
+        ThreadPool* m_threadPool = nullptr;
+        Renderer* m_renderer = nullptr; // From InitAll - DrawAll runs its sorted pass on it
+        size_t m_parallelChunkSize = 64;
+        bool m_inParallelUpdate = false;
+        CollisionManager* m_collisionManager = nullptr;
 
     public:
         EntityManager() = default;
 
-        // Add an entity (takes ownership)
+        // Add an entity (takes ownership). During UpdateAll the entity is constructed
+        // straight away but only joins the manager (and gets a handle) after the update pass.
         template<typename T, typename... Args>
         T* Create(Args&&... args) {
             static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity");
-            auto entity = std::make_unique<T>(std::forward<Args>(args)...);
-            T* ptr = entity.get();
-            AddToTagIndex(ptr);
-            m_entities.push_back(std::move(entity));
-            m_needsSort = true;
+            // Worker threads can't share the arena, so their entities go on the heap
+            bool useArena = m_useArena && ThreadPool::CurrentWorkerIndex() < 0;
+            EntityPtr entity = useArena
+                ? m_arena.Create<T>(std::forward<Args>(args)...)
+                : EntityPtr(new T(std::forward<Args>(args)...), EntityDeleter{});
+            T* ptr = static_cast<T*>(entity.get());
+            if (EntityCommandBuffer* buffer = CurrentCommandBuffer()) {
+                buffer->PushCreate(std::move(entity), GetTypeId<T>());
+                return ptr;
+            }
+            Insert(std::move(entity));
+            AddToTypeIndex(ptr, GetTypeId<T>());
             return ptr;
         }
 
-        // Add an existing entity (takes ownership)
+        // Add an existing entity (takes ownership, always heap-allocated)
         Entity* Add(std::unique_ptr<Entity> entity) {
-            Entity* ptr = entity.get();
-            AddToTagIndex(ptr);
-            m_entities.push_back(std::move(entity));
-            m_needsSort = true;
+            if (EntityCommandBuffer* buffer = CurrentCommandBuffer()) {
+                return buffer->Add(std::move(entity));
+            }
+            Entity* ptr = entity.release();
+            Insert(EntityPtr(ptr, EntityDeleter{}));
             return ptr;
         }
 
-        // Mark entity for removal (safe to call during update)
+        // Allocate entities made by Create<T> from per-type slabs instead of individually
+        // on the heap. Entities of one type then sit contiguously, and Clear() rewinds the
+        // whole arena at once. Only affects entities created after the call.
+        void SetUseArena(bool useArena) { m_useArena = useArena; }
+        bool GetUseArena() const { return m_useArena; }
+
+        // Hand arena memory back to the system (otherwise kept for reuse after Clear)
+        void ReleaseArenaMemory() {
+            if (m_arena.GetLiveCount() == 0) {
+                m_arena.Release();
+            }
+        }
+
+        // Mark entity for removal (safe to call during update, including on an entity
+        // created earlier in the same update)
         void Remove(Entity* entity) {
-            m_pendingRemoval.push_back(entity);
+            if (!entity) return;
+            EntityCommandBuffer* buffer = CurrentCommandBuffer();
+            if (buffer && (m_inParallelUpdate || entity->GetHandle().IsNull())) {
+                buffer->Remove(entity);
+                return;
+            }
+            Remove(entity->GetHandle());
+        }
+
+        // Mark entity for removal by handle - stale handles and repeat calls are ignored
+        void Remove(EntityHandle handle) {
+            if (m_inParallelUpdate) {
+                CurrentCommandBuffer()->Remove(handle);
+                return;
+            }
+            if (IsValid(handle) && !m_slots[handle.index].pendingRemoval) {
+                m_slots[handle.index].pendingRemoval = true;
+                m_pendingRemoval.push_back(handle);
+            }
         }
 
         // Remove all entities with a specific tag
+        void RemoveByTag(TagId tag) {
+            for (Entity* entity : FindAllByTag(tag)) {
+                Remove(entity->GetHandle());
+            }
+        }
+
         void RemoveByTag(const std::string& tag) {
-            auto it = m_tagIndex.find(tag);
-            if (it != m_tagIndex.end()) {
-                for (Entity* entity : it->second) {
-                    m_pendingRemoval.push_back(entity);
-                }
+            RemoveByTag(TagRegistry::Find(tag));
+        }
+
+        // Add or remove a tag at runtime, keeping the tag index in sync.
+        // Deferred to the end of the update pass when called during UpdateAll.
+        void AddTag(Entity* entity, TagId tag) {
+            if (!entity) return;
+            if (EntityCommandBuffer* buffer = CurrentCommandBuffer()) {
+                buffer->AddTag(entity, tag);
+                return;
+            }
+            ApplyTagChange(entity, tag, true);
+        }
+
+        void AddTag(Entity* entity, const std::string& tag) {
+            AddTag(entity, TagRegistry::Intern(tag));
+        }
+
+        void RemoveTag(Entity* entity, TagId tag) {
+            if (!entity) return;
+            if (EntityCommandBuffer* buffer = CurrentCommandBuffer()) {
+                buffer->RemoveTag(entity, tag);
+                return;
+            }
+            if (ApplyTagChange(entity, tag, false)) {
+                CompactTagBuckets(TagRegistry::ToMask(tag));
             }
         }
 
+        void RemoveTag(Entity* entity, const std::string& tag) {
+            RemoveTag(entity, TagRegistry::Find(tag));
+        }
+
+        // Change an entity's render layer (same as Entity::SetRenderLayer, but recorded in
+        // order with the other structural changes). Deferred to the end of the update pass when called during UpdateAll.
+        void SetRenderLayer(Entity* entity, int renderLayer) {
+            if (!entity) return;
+            if (EntityCommandBuffer* buffer = CurrentCommandBuffer()) {
+                buffer->SetRenderLayer(entity, renderLayer);
+                return;
+            }
+            ApplyLayerChange(entity, renderLayer);
+        }
+
+        // Apply a recorded buffer in one batch: one reserve for the creates and one pass over
+        // the tag index. Call outside UpdateAll (which plays back its own
+        // buffers). Removals take effect at the end of the next UpdateAll.
+        void Playback(EntityCommandBuffer& buffer) {
+            PlaybackBuffers(&buffer, 1);
+        }
+
+        // Check if an entity is queued for removal at the end of this update
+        bool IsPendingRemoval(EntityHandle handle) const {
+            return IsValid(handle) && m_slots[handle.index].pendingRemoval;
+        }
+
+        // Check if a handle still refers to a live entity - O(1)
+        bool IsValid(EntityHandle handle) const {
+            return handle.index < m_slots.size() &&
+                   m_slots[handle.index].generation == handle.generation &&
+                   m_slots[handle.index].entity != nullptr;
+        }
+
+        // Resolve a handle (nullptr if the entity has been removed) - O(1)
+        Entity* Get(EntityHandle handle) const {
+            return IsValid(handle) ? m_slots[handle.index].entity : nullptr;
+        }
+
+        template<typename T>
+        T* Get(EntityHandle handle) const {
+            static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity");
+            return dynamic_cast<T*>(Get(handle));
+        }
+
         // Get first entity with tag (nullptr if not found) - O(1)
+        Entity* FindByTag(TagId tag) {
+            const std::vector<Entity*>& bucket = FindAllByTag(tag);
+            return bucket.empty() ? nullptr : bucket.front();
+        }
+
         Entity* FindByTag(const std::string& tag) {
-            auto it = m_tagIndex.find(tag);
-            if (it != m_tagIndex.end() && !it->second.empty()) {
-                return it->second.front();
-            }
-            return nullptr;
+            return FindByTag(TagRegistry::Find(tag));
+        }
+
+        // Get handle of first entity with tag (null handle if not found) - O(1)
+        EntityHandle FindHandleByTag(TagId tag) {
+            Entity* entity = FindByTag(tag);
+            return entity ? entity->GetHandle() : EntityHandle();
+        }
+
+        EntityHandle FindHandleByTag(const std::string& tag) {
+            return FindHandleByTag(TagRegistry::Find(tag));
         }
 
         // Get all entities with tag - O(1)
-        const std::vector<Entity*>& FindAllByTag(const std::string& tag) {
-            auto it = m_tagIndex.find(tag);
-            if (it != m_tagIndex.end()) {
-                return it->second;
+        const std::vector<Entity*>& FindAllByTag(TagId tag) const {
+            if (tag < m_tagIndex.size()) {
+                return m_tagIndex[tag];
             }
             static const std::vector<Entity*> empty;
             return empty;
         }
 
+        const std::vector<Entity*>& FindAllByTag(const std::string& tag) const {
+            return FindAllByTag(TagRegistry::Find(tag));
+        }
+
         // Get all entities (for custom iteration)
         std::vector<Entity*> GetAll() {
             std::vector<Entity*> result;
@@ -90,8 +290,9 @@ namespace Engine {
             return result;
         }
 
-        // Iterate over entities with a callback
-        void ForEach(const std::function<void(Entity*)>& callback) {
+        // Iterate over entities with a callback (templated so lambdas inline - no std::function)
+        template<typename Fn>
+        void ForEach(Fn&& callback) {
             for (auto& entity : m_entities) {
                 if (entity) {
                     callback(entity.get());
@@ -99,18 +300,56 @@ namespace Engine {
             }
         }
 
-        // Iterate over entities with specific tag - O(n) where n = entities with tag
-        void ForEachWithTag(const std::string& tag, const std::function<void(Entity*)>& callback) {
-            auto it = m_tagIndex.find(tag);
-            if (it != m_tagIndex.end()) {
-                for (Entity* entity : it->second) {
-                    callback(entity);
+        // Iterate over entities in draw order (render layer, then insertion order)
+        template<typename Fn>
+        void ForEachInDrawOrder(Fn&& callback) {
+            for (auto& layer : m_layers) {
+                for (Entity* entity : layer.second.entities) {
+                    if (entity) {
+                        callback(entity);
+                    }
                 }
             }
         }
 
+        // Iterate over entities with specific tag - O(n) where n = entities with tag
+        template<typename Fn>
+        void ForEachWithTag(TagId tag, Fn&& callback) {
+            for (Entity* entity : FindAllByTag(tag)) {
+                callback(entity);
+            }
+        }
+
+        template<typename Fn>
+        void ForEachWithTag(const std::string& tag, Fn&& callback) {
+            ForEachWithTag(TagRegistry::Find(tag), std::forward<Fn>(callback));
+        }
+
+        // Iterate over entities created as exactly T via Create<T> - no dynamic_cast.
+        // Subclasses of T and entities passed to Add() are not included.
+        template<typename T, typename Fn>
+        void ForEachOfType(Fn&& callback) {
+            static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity");
+            TypeId id = GetTypeId<T>();
+            if (id >= m_typeIndex.size()) return;
+            for (Entity* entity : m_typeIndex[id]) {
+                callback(static_cast<T*>(entity));
+            }
+        }
+
+        // Get count of entities created as exactly T - O(1)
+        template<typename T>
+        size_t CountByType() const {
+            TypeId id = GetTypeId<T>();
+            return id < m_typeIndex.size() ? m_typeIndex[id].size() : 0;
+        }
+
         // Initialize all entities (injects dependencies, then calls Init)
         void InitAll(Renderer& renderer, CollisionManager* collisionManager = nullptr, GameMeta* gameMeta = nullptr, AudioManager* audioManager = nullptr) {
+            if (collisionManager) {
+                m_collisionManager = collisionManager;
+            }
+            m_renderer = &renderer;
             for (auto& entity : m_entities) {
                 if (entity) {
                     entity->SetRenderer(&renderer);
@@ -123,91 +362,658 @@ namespace Engine {
             }
         }
 
-        // Update all entities
+        // Give an entity a row in the component store (transform starts at its position).
+        // Each update the row picks up the entity's current position, integrates velocity
+        // and writes the result back, so moving the entity directly still sticks.
+        ComponentHandle AddComponents(Entity* entity) {
+            if (!entity || !IsValid(entity->GetHandle())) return ComponentHandle();
+            Slot& slot = m_slots[entity->GetHandle().index];
+            if (!m_components.IsValid(slot.components)) {
+                slot.components = m_components.Create(entity->GetPosition(), entity->GetHandle());
+            }
+            return slot.components;
+        }
+
+        // Component row owned by an entity (null handle if it has none)
+        ComponentHandle GetComponents(Entity* entity) const {
+            if (!entity || !IsValid(entity->GetHandle())) return ComponentHandle();
+            return m_slots[entity->GetHandle().index].components;
+        }
+
+        // Data-oriented storage - also usable for rows that have no Entity at all
+        ComponentStore& GetComponentStore() { return m_components; }
+
+        // Run Update for thread-safe entities across a worker pool (nullptr = serial).
+        // The pool is not owned and must outlive the manager's updates.
+        void SetThreadPool(ThreadPool* threadPool, size_t chunkSize = 64) {
+            m_threadPool = threadPool;
+            m_parallelChunkSize = chunkSize;
+        }
+
+        ThreadPool* GetThreadPool() const { return m_threadPool; }
+
+        // Collision manager whose registrations are deferred during parallel updates
+        // (set automatically by InitAll)
+        void SetCollisionManager(CollisionManager* collisionManager) { m_collisionManager = collisionManager; }
+
+        // Update all entities (component systems run first, then per-entity Update).
+        // Structural changes made during the pass are played back once it finishes.
         void UpdateAll(float deltaTime) {
-            for (auto& entity : m_entities) {
-                if (entity) {
-                    entity->Update(deltaTime);
+            UpdateComponents(deltaTime);
+            UpdateActivation();
+            if (m_activeDirty || m_activeHoles * 4 > m_active.size()) {
+                RebuildActive();
+            }
+
+            m_updating = true;
+            if (m_threadPool && m_threadPool->GetThreadCount() > 1) {
+                UpdateParallel(deltaTime);
+            } else {
+                // Index loop - entities woken during the pass are appended and start next frame
+                size_t count = m_active.size();
+                for (size_t i = 0; i < count; i++) {
+                    if (Entity* entity = m_active[i]) {
+                        m_commands.SetSource(i);
+                        entity->Update(deltaTime);
+                    }
                 }
             }
+            m_updating = false;
+            PlaybackBuffers(&m_commands, 1);
             ProcessRemovals();
         }
 
-        // Draw all entities (sorted by render layer)
+        // Draw all entities by render layer, in insertion order within a layer. Component
+        // rows with render info draw on layer 0, before that layer's entities. When the
+        // renderer is sorting, the whole call is one sorted pass and draws are tagged with
+        // the entity's layer, so the renderer may regroup them by texture within a layer.
         void DrawAll() {
-            if (m_needsSort) {
-                SortByRenderLayer();
-                m_needsSort = false;
+            int previousLayer = 0;
+            if (m_renderer) {
+                previousLayer = m_renderer->GetRenderLayer();
+                m_renderer->BeginSortedPass();
+            }
+            bool componentsDrawn = !m_renderer || m_components.Count() == 0;
+            m_drawing = true;
+            for (auto it = m_layers.begin(); it != m_layers.end();) {
+                LayerBucket& bucket = it->second;
+                if (bucket.holes * 4 > bucket.entities.size()) {
+                    CompactLayer(bucket);
+                }
+                if (bucket.entities.empty()) {
+                    it = m_layers.erase(it);
+                    continue;
+                }
+                if (!componentsDrawn && it->first >= 0) {
+                    DrawComponents();
+                    componentsDrawn = true;
+                }
+                if (m_renderer) m_renderer->SetRenderLayer(it->first);
+                // Index loop - Draw may create entities into this bucket
+                size_t count = bucket.entities.size();
+                for (size_t i = 0; i < count; i++) {
+                    Entity* entity = bucket.entities[i];
+                    if (entity && entity->m_state != EntityState::Dormant) {
+                        entity->Draw();
+                    }
+                }
+                ++it;
+            }
+            if (!componentsDrawn) DrawComponents();
+            m_drawing = false;
+            if (m_renderer) {
+                m_renderer->SetRenderLayer(previousLayer);
+                m_renderer->EndSortedPass();
             }
 
-            for (auto& entity : m_entities) {
-                if (entity) {
-                    entity->Draw();
+            // Layer changes made from Draw take effect next frame
+            for (EntityHandle handle : m_deferredLayerMoves) {
+                if (Entity* entity = Get(handle)) {
+                    MoveToLayer(entity);
                 }
             }
+            m_deferredLayerMoves.clear();
         }
 
-        // Force re-sort (call if you change an entity's render layer)
-        void MarkDirty() {
-            m_needsSort = true;
-        }
+        // No longer needed - draw order follows SetRenderLayer automatically
+        void MarkDirty() {}
 
         // Get entity count
         size_t Count() const {
             return m_entities.size();
         }
 
+        // Entities that UpdateAll visits / that are asleep / that are dormant (outside the
+        // activation region) - the three always add up to Count()
+        size_t GetActiveCount() const { return m_entities.size() - m_sleepingCount - m_dormantCount; }
+        size_t GetSleepingCount() const { return m_sleepingCount; }
+        size_t GetDormantCount() const { return m_dormantCount; }
+
+        // Auto-sleep entities (Entity::SetAutoSleep) outside the camera's view grown by margin
+        // on every side go dormant, and wake again once their position is back inside.
+        // The camera is not owned; pass nullptr to turn the region off (dormant entities wake).
+        void SetActivationRegion(const Camera* camera, float margin) {
+            m_activationCamera = camera;
+            m_activationMargin = margin;
+            if (!camera) {
+                for (EntityHandle handle : m_autoSleepers) {
+                    Entity* entity = Get(handle);
+                    if (entity && entity->m_state == EntityState::Dormant) {
+                        ChangeState(entity, EntityState::Active);
+                    }
+                }
+            }
+        }
+
         // Get count of entities with specific tag - O(1)
+        size_t CountByTag(TagId tag) const {
+            return FindAllByTag(tag).size();
+        }
+
         size_t CountByTag(const std::string& tag) const {
-            auto it = m_tagIndex.find(tag);
-            return it != m_tagIndex.end() ? it->second.size() : 0;
+            return CountByTag(TagRegistry::Find(tag));
         }
 
-        // Clear all entities
+        // Clear all entities (outstanding handles become stale)
         void Clear() {
+            // Entities still waiting in a buffer may live in the arena, so drop them first
+            m_commands.Clear();
+            for (EntityCommandBuffer& buffer : m_workerBuffers) {
+                buffer.Clear();
+            }
+
+            // Run destructors, but skip returning arena blocks one by one - the
+            // arena is rewound in a single step afterwards
+            for (EntityPtr& entity : m_entities) {
+                bool inArena = entity.get_deleter().slab != nullptr;
+                Entity* ptr = entity.release();
+                if (inArena) {
+                    ptr->~Entity();
+                } else {
+                    delete ptr;
+                }
+            }
             m_entities.clear();
-            m_tagIndex.clear();
+            m_arena.Reset();
+            for (uint32_t i = 0; i < m_slots.size(); i++) {
+                if (m_slots[i].entity) {
+                    ReleaseSlot(i);
+                }
+            }
+            for (auto& bucket : m_tagIndex) {
+                bucket.clear();
+            }
+            m_layers.clear();
+            m_deferredLayerMoves.clear();
+            m_active.clear();
+            m_activeHoles = 0;
+            m_activeDirty = false;
+            m_sleepingCount = 0;
+            m_dormantCount = 0;
+            m_autoSleepers.clear();
+            m_typeIndex.clear();
+            m_components.Clear();
             m_pendingRemoval.clear();
         }
 
     private:
+        void Insert(EntityPtr entity) {
+            Entity* ptr = entity.get();
+            ptr->m_handle = AcquireSlot(ptr);
+            ptr->m_owner = this;
+            AddToTagIndex(ptr);
+            AddToLayer(ptr);
+            m_entities.push_back(std::move(entity));
+            CountState(ptr->m_state, 1);
+            if (ptr->m_state == EntityState::Active) {
+                AddToActive(ptr);
+            }
+            if (ptr->m_bAutoSleep) {
+                OnAutoSleepChanged(ptr);
+            }
+        }
+
+        void AddToLayer(Entity* entity) {
+            Slot& slot = m_slots[entity->m_handle.index];
+            LayerBucket& bucket = m_layers[entity->GetRenderLayer()];
+            slot.drawLayer = entity->GetRenderLayer();
+            slot.drawIndex = static_cast<uint32_t>(bucket.entities.size());
+            bucket.entities.push_back(entity);
+        }
+
+        void RemoveFromLayer(const Slot& slot) {
+            LayerBucket& bucket = m_layers[slot.drawLayer];
+            bucket.entities[slot.drawIndex] = nullptr;
+            bucket.holes++;
+        }
+
+        void MoveToLayer(Entity* entity) {
+            const Slot& slot = m_slots[entity->m_handle.index];
+            if (slot.drawLayer == entity->GetRenderLayer()) return;
+            RemoveFromLayer(slot);
+            AddToLayer(entity);
+        }
+
+        void CompactLayer(LayerBucket& bucket) {
+            size_t write = 0;
+            for (Entity* entity : bucket.entities) {
+                if (entity) {
+                    m_slots[entity->m_handle.index].drawIndex = static_cast<uint32_t>(write);
+                    bucket.entities[write++] = entity;
+                }
+            }
+            bucket.entities.resize(write);
+            bucket.holes = 0;
+        }
+
+        void CountState(EntityState state, int delta) {
+            if (state == EntityState::Sleeping) m_sleepingCount += delta;
+            if (state == EntityState::Dormant) m_dormantCount += delta;
+        }
+
+        void AddToActive(Entity* entity) {
+            Slot& slot = m_slots[entity->m_handle.index];
+            // Appending keeps insertion order only if nothing listed comes after the entity.
+            // Skip holes at the end - the last live entry is what the order depends on.
+            Entity* last = nullptr;
+            for (size_t i = m_active.size(); i-- > 0 && !last;) {
+                last = m_active[i];
+            }
+            if (last && m_slots[last->m_handle.index].denseIndex > slot.denseIndex) {
+                m_activeDirty = true;
+                return;
+            }
+            slot.activeIndex = static_cast<uint32_t>(m_active.size());
+            m_active.push_back(entity);
+        }
+
+        void RemoveFromActive(Slot& slot) {
+            if (slot.activeIndex == EntityHandle::InvalidIndex) return;
+            m_active[slot.activeIndex] = nullptr;
+            slot.activeIndex = EntityHandle::InvalidIndex;
+            m_activeHoles++;
+        }
+
+        void RebuildActive() {
+            m_active.clear();
+            for (EntityPtr& entity : m_entities) {
+                Slot& slot = m_slots[entity->m_handle.index];
+                if (entity->m_state == EntityState::Active) {
+                    slot.activeIndex = static_cast<uint32_t>(m_active.size());
+                    m_active.push_back(entity.get());
+                } else {
+                    slot.activeIndex = EntityHandle::InvalidIndex;
+                }
+            }
+            m_activeHoles = 0;
+            m_activeDirty = false;
+        }
+
+        void ChangeState(Entity* entity, EntityState state) {
+            if (entity->m_state == state) return;
+            if (!IsValid(entity->m_handle)) {
+                entity->m_state = state; // Not added yet - Insert picks it up
+                return;
+            }
+            Slot& slot = m_slots[entity->m_handle.index];
+            CountState(entity->m_state, -1);
+            CountState(state, 1);
+            if (entity->m_state == EntityState::Active) {
+                RemoveFromActive(slot);
+            }
+            entity->m_state = state;
+            if (state == EntityState::Active) {
+                AddToActive(entity);
+            }
+        }
+
+        void UpdateActivation() {
+            if (!m_activationCamera || m_autoSleepers.empty()) return;
+            float minX = m_activationCamera->GetPosition().GetX() - m_activationMargin;
+            float minY = m_activationCamera->GetPosition().GetY() - m_activationMargin;
+            float maxX = minX + m_activationCamera->GetSize().GetX() + m_activationMargin * 2.0f;
+            float maxY = minY + m_activationCamera->GetSize().GetY() + m_activationMargin * 2.0f;
+
+            // Drops removed entities and ones that turned auto-sleep off as it goes
+            size_t write = 0;
+            for (EntityHandle handle : m_autoSleepers) {
+                Entity* entity = Get(handle);
+                if (!entity) continue;
+                if (!entity->m_bAutoSleep) {
+                    m_slots[handle.index].autoSleep = false;
+                    continue;
+                }
+                m_autoSleepers[write++] = handle;
+
+                Vector2f position = entity->GetPosition();
+                bool inside = position.GetX() >= minX && position.GetX() <= maxX &&
+                              position.GetY() >= minY && position.GetY() <= maxY;
+                if (inside && entity->m_state == EntityState::Dormant) {
+                    ChangeState(entity, EntityState::Active);
+                } else if (!inside && entity->m_state == EntityState::Active) {
+                    ChangeState(entity, EntityState::Dormant);
+                }
+            }
+            m_autoSleepers.resize(write);
+        }
+
+        void OnStateRequested(Entity* entity, EntityState state) override {
+            if (m_inParallelUpdate) {
+                EntityCommandBuffer* buffer = CurrentCommandBuffer();
+                buffer->m_stateChanges.push_back({entity, state, buffer->m_source});
+                return;
+            }
+            ChangeState(entity, state);
+        }
+
+        void OnAutoSleepChanged(Entity* entity) override {
+            if (!IsValid(entity->m_handle)) return;
+            Slot& slot = m_slots[entity->m_handle.index];
+            if (entity->m_bAutoSleep && !slot.autoSleep) {
+                slot.autoSleep = true;
+                m_autoSleepers.push_back(entity->m_handle);
+            } else if (!entity->m_bAutoSleep && entity->m_state == EntityState::Dormant) {
+                ChangeState(entity, EntityState::Active);
+            }
+        }
+
+        void OnRenderLayerChanged(Entity* entity) override {
+            if (!IsValid(entity->m_handle)) return;
+            if (m_inParallelUpdate) {
+                // The entity already holds its new layer; only the bucket move waits for playback
+                CurrentCommandBuffer()->SetRenderLayer(entity, entity->GetRenderLayer());
+            } else if (m_drawing) {
+                m_deferredLayerMoves.push_back(entity->m_handle);
+            } else {
+                MoveToLayer(entity);
+            }
+        }
+
+        EntityHandle AcquireSlot(Entity* entity) {
+            uint32_t index;
+            if (!m_freeSlots.empty()) {
+                index = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            } else {
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+            Slot& slot = m_slots[index];
+            slot.entity = entity;
+            slot.denseIndex = static_cast<uint32_t>(m_entities.size());
+            return EntityHandle(index, slot.generation);
+        }
+
+        void AddToTypeIndex(Entity* entity, TypeId typeId) {
+            if (typeId >= m_typeIndex.size()) {
+                m_typeIndex.resize(typeId + 1);
+            }
+            m_typeIndex[typeId].push_back(entity);
+            m_slots[entity->m_handle.index].typeId = typeId;
+        }
+
+        void ReleaseSlot(uint32_t index) {
+            Slot& slot = m_slots[index];
+            slot.entity = nullptr;
+            slot.typeId = NoTypeId;
+            slot.components = ComponentHandle();
+            slot.activeIndex = EntityHandle::InvalidIndex;
+            slot.pendingRemoval = false;
+            slot.autoSleep = false;
+            slot.generation++; // Invalidates every handle issued for this slot
+            m_freeSlots.push_back(index);
+        }
+
         void AddToTagIndex(Entity* entity) {
-            for (const std::string& tag : entity->GetTags()) {
+            TagRegistry::ForEachTag(entity->GetTagMask(), [this, entity](TagId tag) {
                 m_tagIndex[tag].push_back(entity);
+            });
+        }
+
+        // Buffer that structural changes on this thread should go to (nullptr = apply now)
+        EntityCommandBuffer* CurrentCommandBuffer() {
+            if (m_inParallelUpdate) {
+                // Small jobs run inline on the calling thread, which then acts as worker 0
+                int worker = ThreadPool::CurrentWorkerIndex();
+                return &m_workerBuffers[worker < 0 ? 0 : worker];
+            }
+            return m_updating ? &m_commands : nullptr;
+        }
+
+        // Returns true if the tag was removed from an indexed entity (its bucket needs compacting)
+        bool ApplyTagChange(Entity* entity, TagId tag, bool add) {
+            TagMask bit = TagRegistry::ToMask(tag);
+            if (!bit || entity->HasAnyTag(bit) == add) return false;
+            bool indexed = IsValid(entity->m_handle) && m_slots[entity->m_handle.index].entity == entity;
+            if (add) {
+                entity->m_tagMask |= bit;
+                if (indexed) m_tagIndex[tag].push_back(entity);
+                return false;
             }
+            entity->m_tagMask &= ~bit;
+            return indexed;
         }
 
-        void RemoveFromTagIndex(Entity* entity) {
-            for (const std::string& tag : entity->GetTags()) {
-                auto it = m_tagIndex.find(tag);
-                if (it != m_tagIndex.end()) {
-                    auto& vec = it->second;
-                    vec.erase(std::remove(vec.begin(), vec.end(), entity), vec.end());
+        void ApplyLayerChange(Entity* entity, int renderLayer) {
+            if (entity->GetRenderLayer() != renderLayer) {
+                entity->SetRenderLayer(renderLayer); // Moves buckets if the entity is already owned
+            } else if (IsValid(entity->m_handle) && m_slots[entity->m_handle.index].entity == entity) {
+                MoveToLayer(entity); // Layer set from a worker thread - bring the bucket up to date
+            }
+        }
+
+        // Drop entities that no longer carry the tag from each bucket in tags. A tag removed and
+        // re-added in one batch leaves a duplicate entry, so only the first entry is kept:
+        // the tag bit doubles as a "seen" marker during the pass and is restored after.
+        void CompactTagBuckets(TagMask tags) {
+            TagRegistry::ForEachTag(tags, [this](TagId tag) {
+                TagMask bit = TagRegistry::ToMask(tag);
+                std::vector<Entity*>& bucket = m_tagIndex[tag];
+                bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                    [bit](Entity* entity) {
+                        if (!entity->HasAnyTag(bit)) return true;
+                        entity->m_tagMask &= ~bit;
+                        return false;
+                    }), bucket.end());
+                for (Entity* entity : bucket) {
+                    entity->m_tagMask |= bit;
                 }
+            });
+        }
+
+        // Collect one kind of command from every buffer, ordered by the entity that recorded it
+        // so the result doesn't depend on how work was split across threads
+        template<typename Command>
+        static void GatherCommands(EntityCommandBuffer* buffers, size_t count,
+                                   std::vector<Command> EntityCommandBuffer::* commands,
+                                   std::vector<Command*>& out) {
+            out.clear();
+            for (size_t i = 0; i < count; i++) {
+                for (Command& command : buffers[i].*commands) {
+                    out.push_back(&command);
+                }
+            }
+            if (count > 1) {
+                std::stable_sort(out.begin(), out.end(), [](const Command* a, const Command* b) {
+                    return a->source < b->source;
+                });
             }
         }
 
-        void ProcessRemovals() {
-            if (m_pendingRemoval.empty()) return;
+        void PlaybackBuffers(EntityCommandBuffer* buffers, size_t count) {
+            // Creates: one reserve, then insert in order
+            GatherCommands(buffers, count, &EntityCommandBuffer::m_creates, m_createScratch);
+            if (!m_createScratch.empty()) {
+                m_entities.reserve(m_entities.size() + m_createScratch.size());
+                for (EntityCommandBuffer::CreateCommand* create : m_createScratch) {
+                    Entity* ptr = create->entity.get();
+                    Insert(std::move(create->entity));
+                    if (create->typeId != NoTypeId) {
+                        AddToTypeIndex(ptr, create->typeId);
+                    }
+                }
+            }
 
-            for (Entity* toRemove : m_pendingRemoval) {
-                RemoveFromTagIndex(toRemove);
-                auto it = std::find_if(m_entities.begin(), m_entities.end(),
-                    [toRemove](const std::unique_ptr<Entity>& e) {
-                        return e.get() == toRemove;
-                    });
-                if (it != m_entities.end()) {
-                    m_entities.erase(it);
+            // Tag changes: additions append, removals compact each touched bucket once
+            GatherCommands(buffers, count, &EntityCommandBuffer::m_tagChanges, m_tagScratch);
+            TagMask removedTags = 0;
+            for (EntityCommandBuffer::TagCommand* change : m_tagScratch) {
+                if (ApplyTagChange(change->entity, change->tag, change->add)) {
+                    removedTags |= TagRegistry::ToMask(change->tag);
                 }
             }
-            m_pendingRemoval.clear();
+            CompactTagBuckets(removedTags);
+
+            // Render layers
+            GatherCommands(buffers, count, &EntityCommandBuffer::m_layerChanges, m_layerScratch);
+            for (EntityCommandBuffer::LayerCommand* change : m_layerScratch) {
+                ApplyLayerChange(change->entity, change->renderLayer);
+            }
+
+            // Sleep/wake
+            GatherCommands(buffers, count, &EntityCommandBuffer::m_stateChanges, m_stateScratch);
+            for (EntityCommandBuffer::StateCommand* change : m_stateScratch) {
+                ChangeState(change->entity, change->state);
+            }
+
+            // Removals last, so entities created in the same batch can be resolved to handles
+            for (size_t i = 0; i < count; i++) {
+                for (const EntityCommandBuffer::RemoveCommand& remove : buffers[i].m_removes) {
+                    Remove(remove.entity ? remove.entity->GetHandle() : remove.handle);
+                }
+                buffers[i].Clear();
+            }
         }
 
-        void SortByRenderLayer() {
-            std::stable_sort(m_entities.begin(), m_entities.end(),
-                [](const std::unique_ptr<Entity>& a, const std::unique_ptr<Entity>& b) {
-                    return a->GetRenderLayer() < b->GetRenderLayer();
+        // Thread-safe entities update in chunks across the pool, structural changes are merged
+        // at the sync point, then the remaining entities update serially on this thread
+        void UpdateParallel(float deltaTime) {
+            size_t workerCount = m_threadPool->GetThreadCount();
+            if (m_workerBuffers.size() < workerCount) {
+                m_workerBuffers.resize(workerCount);
+            }
+            if (m_collisionManager) {
+                m_collisionManager->BeginDeferred(workerCount);
+            }
+
+            m_inParallelUpdate = true;
+            m_threadPool->ParallelFor(m_active.size(), m_parallelChunkSize,
+                [this, deltaTime](size_t begin, size_t end, size_t worker) {
+                    EntityCommandBuffer& buffer = m_workerBuffers[worker];
+                    for (size_t i = begin; i < end; i++) {
+                        Entity* entity = m_active[i];
+                        if (entity && entity->IsThreadSafe()) {
+                            buffer.SetSource(i);
+                            if (m_collisionManager) m_collisionManager->SetDeferredSource(worker, i);
+                            entity->Update(deltaTime);
+                        }
+                    }
                 });
+            m_inParallelUpdate = false;
+
+            if (m_collisionManager) {
+                m_collisionManager->EndDeferred();
+            }
+
+            // Sync point: worker changes are visible to the serial entities
+            size_t serialCount = m_active.size();
+            PlaybackBuffers(m_workerBuffers.data(), workerCount);
+
+            for (size_t i = 0; i < serialCount; i++) {
+                Entity* entity = m_active[i];
+                if (entity && !entity->IsThreadSafe()) {
+                    m_commands.SetSource(i);
+                    entity->Update(deltaTime);
+                }
+            }
+        }
+
+        void DrawComponents() {
+            m_renderer->SetRenderLayer(0);
+            m_components.Draw(*m_renderer);
+        }
+
+        // Owned rows sync both ways: positions set on the entity since the last update are
+        // pulled into the row before integrating, then the result is pushed back
+        void UpdateComponents(float deltaTime) {
+            if (m_components.Count() == 0) return;
+            m_components.ForEachOwned([this](EntityHandle owner, float& x, float& y) {
+                if (Entity* entity = Get(owner)) {
+                    x = entity->GetPosition().GetX();
+                    y = entity->GetPosition().GetY();
+                }
+            });
+            m_components.Integrate(deltaTime);
+            m_components.ForEachOwned([this](EntityHandle owner, float& x, float& y) {
+                if (Entity* entity = Get(owner)) {
+                    entity->SetPosition(Vector2f(x, y));
+                }
+            });
+        }
+
+        // Removals are batched: every marked entity is dropped from its tag buckets and from
+        // m_entities in one compaction pass each, so mass despawns stay linear
+        void ProcessRemovals() {
+            // Destructors may queue further removals, so drain in batches
+            while (!m_pendingRemoval.empty()) {
+                m_removalBatch.swap(m_pendingRemoval);
+                CompactRemovals();
+                m_removalBatch.clear();
+            }
+        }
+
+        void CompactRemovals() {
+            // Collect each touched tag/type bucket once
+            size_t firstDense = m_entities.size();
+            m_touchedBuckets.clear();
+            for (EntityHandle handle : m_removalBatch) {
+                const Slot& slot = m_slots[handle.index];
+                firstDense = std::min(firstDense, static_cast<size_t>(slot.denseIndex));
+                TagRegistry::ForEachTag(slot.entity->GetTagMask(), [this](TagId tag) {
+                    m_touchedBuckets.push_back(&m_tagIndex[tag]);
+                });
+                if (slot.typeId != NoTypeId) {
+                    m_touchedBuckets.push_back(&m_typeIndex[slot.typeId]);
+                }
+            }
+            std::sort(m_touchedBuckets.begin(), m_touchedBuckets.end());
+            m_touchedBuckets.erase(std::unique(m_touchedBuckets.begin(), m_touchedBuckets.end()),
+                                   m_touchedBuckets.end());
+
+            for (std::vector<Entity*>* bucket : m_touchedBuckets) {
+                bucket->erase(std::remove_if(bucket->begin(), bucket->end(),
+                    [this](Entity* entity) {
+                        return m_slots[entity->m_handle.index].pendingRemoval;
+                    }), bucket->end());
+            }
+
+            // Compact m_entities from the first hole onwards, keeping order
+            size_t write = firstDense;
+            for (size_t read = firstDense; read < m_entities.size(); read++) {
+                uint32_t slotIndex = m_entities[read]->m_handle.index;
+                if (m_slots[slotIndex].pendingRemoval) {
+                    m_graveyard.push_back(std::move(m_entities[read]));
+                    continue;
+                }
+                if (write != read) {
+                    m_entities[write] = std::move(m_entities[read]);
+                }
+                m_slots[slotIndex].denseIndex = static_cast<uint32_t>(write);
+                write++;
+            }
+            m_entities.resize(write);
+
+            for (EntityHandle handle : m_removalBatch) {
+                Slot& slot = m_slots[handle.index];
+                RemoveFromActive(slot);
+                CountState(slot.entity->m_state, -1);
+                RemoveFromLayer(slot);
+                m_components.Destroy(m_slots[handle.index].components);
+                ReleaseSlot(handle.index);
+            }
+
+            // Destroy last, once the manager is consistent again
+            m_graveyard.clear();
         }
     };
 }
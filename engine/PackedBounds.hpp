@@ -0,0 +1,159 @@
+#ifndef PACKED_BOUNDS_H
+#define PACKED_BOUNDS_H
+#include "engine/Rectangle.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#define SMITHY_PACKED_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMITHY_PACKED_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(SMITHY_PACKED_AVX2) || defined(SMITHY_PACKED_SSE2))
+#include <intrin.h>
+#endif
+
+namespace Engine {
+    // Rectangle corners copied into four contiguous float arrays (plus a word of layer bits
+    // per slot), so one box can be tested against 8 (AVX2), 4 (SSE2) or 1 (scalar fallback)
+    // others per compare without touching the colliders themselves. Build with -mavx2 (or /arch:AVX2) to get the wide path.
+    class PackedBounds {
+    private:
+        // Raw position and position + size, exactly what CollisionRectangle::IsColliding compares
+        std::vector<float> m_x1;
+        std::vector<float> m_y1;
+        std::vector<float> m_x2;
+        std::vector<float> m_y2;
+        std::vector<uint32_t> m_layerBits; // Filter bits tested alongside the boxes
+
+    public:
+        size_t Size() const { return m_x1.size(); }
+
+        // Append a slot that never overlaps anything until Set
+        void PushBack() {
+            m_x1.push_back(0.0f);
+            m_y1.push_back(0.0f);
+            m_x2.push_back(0.0f);
+            m_y2.push_back(0.0f);
+            m_layerBits.push_back(1u);
+            SetEmpty(m_x1.size() - 1);
+        }
+
+        void Set(size_t index, const Rectangle<float>& rectangle) {
+            Vector2f position = rectangle.GetPosition();
+            Vector2f size = rectangle.GetSize();
+            m_x1[index] = position.GetX();
+            m_y1[index] = position.GetY();
+            m_x2[index] = position.GetX() + size.GetX();
+            m_y2[index] = position.GetY() + size.GetY();
+        }
+
+        void SetLayerBits(size_t index, uint32_t bits) { m_layerBits[index] = bits; }
+
+        // NaN fails every ordered compare, so the slot is skipped without a branch
+        void SetEmpty(size_t index) {
+            float nan = std::numeric_limits<float>::quiet_NaN();
+            m_x1[index] = nan;
+            m_y1[index] = nan;
+            m_x2[index] = nan;
+            m_y2[index] = nan;
+        }
+
+        // Remove a slot, shifting later ones down (keeps the order)
+        void Erase(size_t index) {
+            m_x1.erase(m_x1.begin() + index);
+            m_y1.erase(m_y1.begin() + index);
+            m_x2.erase(m_x2.begin() + index);
+            m_y2.erase(m_y2.begin() + index);
+            m_layerBits.erase(m_layerBits.begin() + index);
+        }
+
+        void Clear() {
+            m_x1.clear();
+            m_y1.clear();
+            m_x2.clear();
+            m_y2.clear();
+            m_layerBits.clear();
+        }
+
+        // Call fn(index) in index order for every slot the query rectangle overlaps, using the
+        // same strict test as CollisionRectangle::IsColliding, whose layer bits intersect
+        // layerMask. fn returns false to stop early.
+        template<typename Fn>
+        void ForEachOverlap(const Rectangle<float>& query, Fn&& fn, uint32_t layerMask = 0xFFFFFFFFu) const {
+            Vector2f position = query.GetPosition();
+            Vector2f size = query.GetSize();
+            const float qx1 = position.GetX();
+            const float qy1 = position.GetY();
+            const float qx2 = position.GetX() + size.GetX();
+            const float qy2 = position.GetY() + size.GetY();
+            const size_t count = m_x1.size();
+            size_t i = 0;
+
+#if defined(SMITHY_PACKED_AVX2)
+            const __m256 x1 = _mm256_set1_ps(qx1);
+            const __m256 y1 = _mm256_set1_ps(qy1);
+            const __m256 x2 = _mm256_set1_ps(qx2);
+            const __m256 y2 = _mm256_set1_ps(qy2);
+            const __m256i mask = _mm256_set1_epi32(static_cast<int>(layerMask));
+            const __m256i zero = _mm256_setzero_si256();
+            for (; i + 8 <= count; i += 8) {
+                __m256 hit = _mm256_and_ps(
+                    _mm256_cmp_ps(x1, _mm256_loadu_ps(&m_x2[i]), _CMP_LT_OQ),
+                    _mm256_cmp_ps(x2, _mm256_loadu_ps(&m_x1[i]), _CMP_GT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(y1, _mm256_loadu_ps(&m_y2[i]), _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(y2, _mm256_loadu_ps(&m_y1[i]), _CMP_GT_OQ));
+                __m256i layers = _mm256_and_si256(mask, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&m_layerBits[i])));
+                hit = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(layers, zero)), hit);
+                for (unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(hit)); bits; bits &= bits - 1) {
+                    if (!fn(i + LowestBit(bits))) return;
+                }
+            }
+#elif defined(SMITHY_PACKED_SSE2)
+            const __m128 x1 = _mm_set1_ps(qx1);
+            const __m128 y1 = _mm_set1_ps(qy1);
+            const __m128 x2 = _mm_set1_ps(qx2);
+            const __m128 y2 = _mm_set1_ps(qy2);
+            const __m128i mask = _mm_set1_epi32(static_cast<int>(layerMask));
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 4 <= count; i += 4) {
+                __m128 hit = _mm_and_ps(
+                    _mm_cmplt_ps(x1, _mm_loadu_ps(&m_x2[i])),
+                    _mm_cmpgt_ps(x2, _mm_loadu_ps(&m_x1[i])));
+                hit = _mm_and_ps(hit, _mm_cmplt_ps(y1, _mm_loadu_ps(&m_y2[i])));
+                hit = _mm_and_ps(hit, _mm_cmpgt_ps(y2, _mm_loadu_ps(&m_y1[i])));
+                __m128i layers = _mm_and_si128(mask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_layerBits[i])));
+                hit = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(layers, zero)), hit);
+                for (unsigned bits = static_cast<unsigned>(_mm_movemask_ps(hit)); bits; bits &= bits - 1) {
+                    if (!fn(i + LowestBit(bits))) return;
+                }
+            }
+#endif
+            // Scalar fallback, and the tail the vector loop didn't cover
+            for (; i < count; i++) {
+                if (qx1 < m_x2[i] && qx2 > m_x1[i] && qy1 < m_y2[i] && qy2 > m_y1[i] && (m_layerBits[i] & layerMask)) {
+                    if (!fn(i)) return;
+                }
+            }
+        }
+
+    private:
+#if defined(SMITHY_PACKED_AVX2) || defined(SMITHY_PACKED_SSE2)
+        static size_t LowestBit(unsigned bits) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return static_cast<size_t>(__builtin_ctz(bits));
+#endif
+        }
+#endif
+    };
+}
+#endif
@@ -3,6 +3,13 @@
 #include <SDL2/SDL.h>
 #include "engine/Vector2.hpp"
 #include "engine/Camera.hpp"
+#include "engine/Rectangle.hpp"
+#include "engine/SpriteBatch.hpp"
+#include "engine/DrawQueue.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
 namespace Engine {
 
     struct Color {
@@ -17,12 +24,51 @@ namespace Engine {
         static Color Yellow() { return Color(255, 255, 0); }
         static Color Cyan() { return Color(0, 255, 255); }
         static Color Magenta() { return Color(255, 0, 255); }
+
+        bool operator==(const Color& other) const {
+            return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+        bool operator!=(const Color& other) const { return !(*this == other); }
+    };
+
+    // Counters since the last ResetStats (call it once a frame for per-frame numbers)
+    struct RenderStats {
+        size_t submitted = 0;               // Draws passed on to SDL (or to a sorted pass)
+        size_t culled = 0;                  // World-space draws dropped for being off camera
+        size_t sortedCommands = 0;          // Draws recorded in sorted passes
+        size_t textureSwitchesUnsorted = 0; // Texture changes the passes would have made in call order
+        size_t textureSwitchesSorted = 0;   // Texture changes after sorting
+
+        // Negative when sorting cost switches (Y-sorted layers can interleave textures)
+        std::ptrdiff_t TextureSwitchesSaved() const {
+            return static_cast<std::ptrdiff_t>(textureSwitchesUnsorted) - static_cast<std::ptrdiff_t>(textureSwitchesSorted);
+        }
     };
 
     class Renderer {
         private:
             SDL_Renderer* m_sdlRenderer = nullptr;
             Camera* m_camera = nullptr;
+            SpriteBatch m_batch;
+            bool m_batching = false;
+
+            SDL_Color m_drawColor = { 0, 0, 0, 255 };
+            SDL_BlendMode m_blendMode = SDL_BLENDMODE_NONE;
+
+            DrawQueue m_queue;
+            bool m_sorting = false;
+            int m_passDepth = 0;
+            int m_renderLayer = 0;
+            bool m_renderLayerYSorted = false;
+            std::vector<int> m_ySortedLayers;
+            std::vector<SDL_Texture*> m_pendingDestroys; // Released during a pass, freed after it
+            RenderStats m_stats;
+
+            bool m_culling = true;
+            float m_cullMargin = 0.0f;
+
+            std::vector<SDL_Rect> m_rectScratch;   // Bulk draws in screen space
+            std::vector<SDL_Point> m_pointScratch;
 
         public:
             Renderer() = default;
@@ -33,21 +79,134 @@ namespace Engine {
             SDL_Renderer* GetSDLRenderer() { return m_sdlRenderer; }
             Camera* GetCamera() { return m_camera; }
 
+            // Batching: sprites are queued instead of drawn, and each run of sprites sharing a
+            // texture goes to the GPU as one SDL_RenderGeometry call. Every other draw, Clear
+            // and a texture change flush the queue first so draw order is kept. Call Flush()
+            // before changing the render target or presenting, and destroy textures that may
+            // still be queued with DestroyTexture. Needs SDL 2.0.18 - on older versions this stays off.
+            void SetBatching(bool enabled) {
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+                enabled = false;
+#endif
+                if (!enabled) Flush();
+                m_batching = enabled;
+            }
+
+            bool IsBatching() const { return m_batching; }
+
+            // Submit queued sprites
+            void Flush() {
+                if (m_batch.IsEmpty()) return;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                SDL_RenderGeometry(m_sdlRenderer, m_batch.GetTexture(),
+                    m_batch.GetVertices(), m_batch.GetVertexCount(),
+                    m_batch.GetIndices(), m_batch.GetIndexCount());
+#endif
+                m_batch.Clear();
+            }
+
+            // SDL_DestroyTexture for textures that draws this frame may still refer to: a batch
+            // using it is flushed first, and inside a sorted pass the texture is kept alive
+            // until the pass has been submitted
+            void DestroyTexture(SDL_Texture* texture) {
+                if (!texture) return;
+                if (texture == m_batch.GetTexture()) Flush();
+                if (IsRecording()) {
+                    m_pendingDestroys.push_back(texture);
+                    return;
+                }
+                SDL_DestroyTexture(texture);
+            }
+
+            // Sorting: draws made between BeginSortedPass and EndSortedPass are recorded with a
+            // key (render layer, Y for Y-sorted layers, texture or draw color, blend mode) and
+            // submitted in key order at the end, so sprites sharing a texture end up next to
+            // each other and batch together. Render layers still draw lowest first, but within
+            // a layer only Y-sorted layers keep an order between different textures - give
+            // anything that must overlap in a fixed order its own layer. EntityManager::DrawAll
+            // runs a pass and sets the layer for each entity; draws outside a pass, and all
+            // draws while sorting is off, happen immediately as before.
+            void SetSorting(bool enabled) {
+                if (!enabled) SubmitQueue();
+                m_sorting = enabled;
+            }
+
+            bool IsSorting() const { return m_sorting; }
+
+            // Within a Y-sorted layer, draws are ordered by their bottom edge (lower on screen
+            // draws later), e.g. for top-down characters walking in front of each other
+            void SetLayerYSorted(int layer, bool ySorted) {
+                auto it = std::find(m_ySortedLayers.begin(), m_ySortedLayers.end(), layer);
+                if (ySorted && it == m_ySortedLayers.end()) m_ySortedLayers.push_back(layer);
+                if (!ySorted && it != m_ySortedLayers.end()) m_ySortedLayers.erase(it);
+                if (layer == m_renderLayer) m_renderLayerYSorted = ySorted;
+            }
+
+            bool IsLayerYSorted(int layer) const {
+                return std::find(m_ySortedLayers.begin(), m_ySortedLayers.end(), layer) != m_ySortedLayers.end();
+            }
+
+            // Layer recorded with the following draws
+            void SetRenderLayer(int layer) {
+                m_renderLayer = layer;
+                m_renderLayerYSorted = IsLayerYSorted(layer);
+            }
+
+            int GetRenderLayer() const { return m_renderLayer; }
+
+            // Passes nest - only the outermost EndSortedPass submits
+            void BeginSortedPass() {
+                if (m_sorting) m_passDepth++;
+            }
+
+            void EndSortedPass() {
+                if (m_passDepth == 0) return;
+                if (--m_passDepth == 0) SubmitQueue();
+            }
+
+            bool IsRecording() const { return m_passDepth > 0; }
+
+            // Culling: world-space draws (sprites, rects, lines, points, and Text::Draw) that
+            // fall entirely outside the camera view plus the margin are dropped before they
+            // reach SDL. Screen-space draws are never culled, and nothing is culled without a
+            // camera that has a size. Turn it off to check whether something is vanishing because of it.
+            void SetCulling(bool enabled) { m_culling = enabled; }
+            bool IsCulling() const { return m_culling; }
+
+            // Extra screen pixels kept around the view, e.g. for drop shadows drawn past a
+            // sprite's bounds
+            void SetCullMargin(float margin) { m_cullMargin = margin > 0.0f ? margin : 0.0f; }
+            float GetCullMargin() const { return m_cullMargin; }
+
+            const RenderStats& GetStats() const { return m_stats; }
+            void ResetStats() { m_stats = RenderStats(); }
+
             // Set draw color
             void SetColor(const Color& color) {
-                SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b, color.a);
+                SetColor(color.r, color.g, color.b, color.a);
             }
 
             void SetColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255) {
+                m_drawColor = SDL_Color{ r, g, b, a };
                 SDL_SetRenderDrawColor(m_sdlRenderer, r, g, b, a);
             }
 
+            // Blend mode for shapes (sprites use their texture's blend mode)
+            void SetBlendMode(SDL_BlendMode blendMode) {
+                m_blendMode = blendMode;
+                SDL_SetRenderDrawBlendMode(m_sdlRenderer, blendMode);
+            }
+
+            SDL_BlendMode GetBlendMode() const { return m_blendMode; }
+
             // Clear screen
             void Clear() {
+                Flush();
                 SDL_RenderClear(m_sdlRenderer);
             }
 
             void Clear(const Color& color) {
+                Flush();
                 SetColor(color);
                 SDL_RenderClear(m_sdlRenderer);
             }
@@ -55,13 +214,13 @@ namespace Engine {
             // Draw filled rectangle (world coordinates - uses camera)
             void DrawFilledRect(const Vector2<float>& worldPos, int width, int height) {
                 Vector2<float> screenPos = WorldToScreen(worldPos);
-                SDL_Rect rect = {
+                if (Cull(screenPos.GetX(), screenPos.GetY(), static_cast<float>(width), static_cast<float>(height))) return;
+                SubmitShape(DrawQueue::CommandType::FilledRect, {
                     static_cast<int>(screenPos.GetX()),
                     static_cast<int>(screenPos.GetY()),
                     width,
                     height
-                };
-                SDL_RenderFillRect(m_sdlRenderer, &rect);
+                });
             }
 
             void DrawFilledRect(float worldX, float worldY, int width, int height) {
@@ -71,13 +230,13 @@ namespace Engine {
             // Draw rectangle outline (world coordinates - uses camera)
             void DrawRect(const Vector2<float>& worldPos, int width, int height) {
                 Vector2<float> screenPos = WorldToScreen(worldPos);
-                SDL_Rect rect = {
+                if (Cull(screenPos.GetX(), screenPos.GetY(), static_cast<float>(width), static_cast<float>(height))) return;
+                SubmitShape(DrawQueue::CommandType::Rect, {
                     static_cast<int>(screenPos.GetX()),
                     static_cast<int>(screenPos.GetY()),
                     width,
                     height
-                };
-                SDL_RenderDrawRect(m_sdlRenderer, &rect);
+                });
             }
 
             void DrawRect(float worldX, float worldY, int width, int height) {
@@ -86,21 +245,23 @@ namespace Engine {
 
             // Draw filled rectangle (screen coordinates - ignores camera)
             void DrawFilledRectScreen(int x, int y, int width, int height) {
-                SDL_Rect rect = { x, y, width, height };
-                SDL_RenderFillRect(m_sdlRenderer, &rect);
+                SubmitShape(DrawQueue::CommandType::FilledRect, { x, y, width, height });
             }
 
             // Draw rectangle outline (screen coordinates - ignores camera)
             void DrawRectScreen(int x, int y, int width, int height) {
-                SDL_Rect rect = { x, y, width, height };
-                SDL_RenderDrawRect(m_sdlRenderer, &rect);
+                SubmitShape(DrawQueue::CommandType::Rect, { x, y, width, height });
             }
 
             // Draw line (world coordinates)
             void DrawLine(const Vector2<float>& worldStart, const Vector2<float>& worldEnd) {
                 Vector2<float> screenStart = WorldToScreen(worldStart);
                 Vector2<float> screenEnd = WorldToScreen(worldEnd);
-                SDL_RenderDrawLine(m_sdlRenderer,
+                float minX = std::min(screenStart.GetX(), screenEnd.GetX());
+                float minY = std::min(screenStart.GetY(), screenEnd.GetY());
+                if (Cull(minX, minY, std::max(screenStart.GetX(), screenEnd.GetX()) - minX + 1.0f,
+                         std::max(screenStart.GetY(), screenEnd.GetY()) - minY + 1.0f)) return;
+                DrawLineScreen(
                     static_cast<int>(screenStart.GetX()),
                     static_cast<int>(screenStart.GetY()),
                     static_cast<int>(screenEnd.GetX()),
@@ -110,68 +271,365 @@ namespace Engine {
 
             // Draw line (screen coordinates)
             void DrawLineScreen(int x1, int y1, int x2, int y2) {
-                SDL_RenderDrawLine(m_sdlRenderer, x1, y1, x2, y2);
+                SubmitShape(DrawQueue::CommandType::Line, { x1, y1, x2, y2 });
             }
 
             // Draw point (world coordinates)
             void DrawPoint(const Vector2<float>& worldPos) {
                 Vector2<float> screenPos = WorldToScreen(worldPos);
-                SDL_RenderDrawPoint(m_sdlRenderer,
+                if (Cull(screenPos.GetX(), screenPos.GetY(), 1.0f, 1.0f)) return;
+                SubmitShape(DrawQueue::CommandType::Point, {
                     static_cast<int>(screenPos.GetX()),
-                    static_cast<int>(screenPos.GetY())
-                );
+                    static_cast<int>(screenPos.GetY()),
+                    0,
+                    0
+                });
+            }
+
+            // Bulk draws (world coordinates): the whole array goes through the camera in one
+            // pass and to SDL in one call, instead of a call per shape. Shapes off camera are
+            // culled one by one, so a large array only submits what's on screen.
+            void DrawRects(const Rectangle<float>* rects, size_t count) {
+                DrawRectangles(DrawQueue::CommandType::Rect, rects, count);
+            }
+
+            void DrawRects(const std::vector<Rectangle<float>>& rects) {
+                DrawRects(rects.data(), rects.size());
+            }
+
+            void DrawFilledRects(const Rectangle<float>* rects, size_t count) {
+                DrawRectangles(DrawQueue::CommandType::FilledRect, rects, count);
+            }
+
+            void DrawFilledRects(const std::vector<Rectangle<float>>& rects) {
+                DrawFilledRects(rects.data(), rects.size());
+            }
+
+            // Connected lines through the points (count - 1 segments), like SDL_RenderDrawLines.
+            // Culled as a whole, by the box around all the points.
+            void DrawLines(const Vector2<float>* points, size_t count) {
+                if (count < 2) return;
+                m_pointScratch.clear();
+                float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+                for (size_t i = 0; i < count; i++) {
+                    Vector2<float> screenPos = WorldToScreen(points[i]);
+                    float x = screenPos.GetX();
+                    float y = screenPos.GetY();
+                    minX = i == 0 ? x : std::min(minX, x);
+                    minY = i == 0 ? y : std::min(minY, y);
+                    maxX = i == 0 ? x : std::max(maxX, x);
+                    maxY = i == 0 ? y : std::max(maxY, y);
+                    m_pointScratch.push_back({ static_cast<int>(x), static_cast<int>(y) });
+                }
+                if (Cull(minX, minY, maxX - minX + 1.0f, maxY - minY + 1.0f)) return;
+
+                m_stats.submitted += count - 1;
+                if (IsRecording()) {
+                    for (size_t i = 1; i < count; i++) {
+                        const SDL_Point& a = m_pointScratch[i - 1];
+                        const SDL_Point& b = m_pointScratch[i];
+                        RecordShape(DrawQueue::CommandType::Line, { a.x, a.y, b.x, b.y });
+                    }
+                    return;
+                }
+                Flush();
+                SDL_RenderDrawLines(m_sdlRenderer, m_pointScratch.data(), static_cast<int>(count));
+            }
+
+            void DrawLines(const std::vector<Vector2<float>>& points) {
+                DrawLines(points.data(), points.size());
+            }
+
+            void DrawPoints(const Vector2<float>* points, size_t count) {
+                m_pointScratch.clear();
+                for (size_t i = 0; i < count; i++) {
+                    Vector2<float> screenPos = WorldToScreen(points[i]);
+                    if (Cull(screenPos.GetX(), screenPos.GetY(), 1.0f, 1.0f)) continue;
+                    m_pointScratch.push_back({ static_cast<int>(screenPos.GetX()), static_cast<int>(screenPos.GetY()) });
+                }
+                if (m_pointScratch.empty()) return;
+
+                m_stats.submitted += m_pointScratch.size();
+                if (IsRecording()) {
+                    for (const SDL_Point& point : m_pointScratch) {
+                        RecordShape(DrawQueue::CommandType::Point, { point.x, point.y, 0, 0 });
+                    }
+                    return;
+                }
+                Flush();
+                SDL_RenderDrawPoints(m_sdlRenderer, m_pointScratch.data(), static_cast<int>(m_pointScratch.size()));
+            }
+
+            void DrawPoints(const std::vector<Vector2<float>>& points) {
+                DrawPoints(points.data(), points.size());
             }
 
             // Draw sprite (world coordinates)
             // srcRect: portion of texture to draw (nullptr for entire texture)
             // width/height: destination size on screen
+            // color: multiplied into every texel (white draws the texture unchanged)
             void DrawSprite(SDL_Texture* texture, const SDL_Rect* srcRect,
-                           const Vector2<float>& worldPos, int width, int height) {
+                           const Vector2<float>& worldPos, int width, int height,
+                           const Color& color = Color::White()) {
                 Vector2<float> screenPos = WorldToScreen(worldPos);
+                if (Cull(screenPos.GetX(), screenPos.GetY(), static_cast<float>(width), static_cast<float>(height))) return;
                 SDL_Rect destRect = {
                     static_cast<int>(screenPos.GetX()),
                     static_cast<int>(screenPos.GetY()),
                     width,
                     height
                 };
-                SDL_RenderCopy(m_sdlRenderer, texture, srcRect, &destRect);
+                SubmitSprite(texture, srcRect, destRect, 0.0, SDL_FLIP_NONE, color);
             }
 
             // Draw sprite with rotation and flip (world coordinates)
             void DrawSpriteEx(SDL_Texture* texture, const SDL_Rect* srcRect,
                              const Vector2<float>& worldPos, int width, int height,
-                             double angle, SDL_RendererFlip flip = SDL_FLIP_NONE) {
+                             double angle, SDL_RendererFlip flip = SDL_FLIP_NONE,
+                             const Color& color = Color::White()) {
                 Vector2<float> screenPos = WorldToScreen(worldPos);
+                float x = screenPos.GetX();
+                float y = screenPos.GetY();
+                float cullWidth = static_cast<float>(width);
+                float cullHeight = static_cast<float>(height);
+                if (angle != 0.0) {
+                    // Any rotation stays inside the circle through the corners
+                    float diagonal = std::sqrt(cullWidth * cullWidth + cullHeight * cullHeight);
+                    x -= (diagonal - cullWidth) * 0.5f;
+                    y -= (diagonal - cullHeight) * 0.5f;
+                    cullWidth = cullHeight = diagonal;
+                }
+                if (Cull(x, y, cullWidth, cullHeight)) return;
                 SDL_Rect destRect = {
                     static_cast<int>(screenPos.GetX()),
                     static_cast<int>(screenPos.GetY()),
                     width,
                     height
                 };
-                SDL_RenderCopyEx(m_sdlRenderer, texture, srcRect, &destRect, angle, nullptr, flip);
+                SubmitSprite(texture, srcRect, destRect, angle, flip, color);
             }
 
             // Draw sprite (screen coordinates - ignores camera)
             void DrawSpriteScreen(SDL_Texture* texture, const SDL_Rect* srcRect,
-                                  int x, int y, int width, int height) {
+                                  int x, int y, int width, int height,
+                                  const Color& color = Color::White()) {
                 SDL_Rect destRect = { x, y, width, height };
-                SDL_RenderCopy(m_sdlRenderer, texture, srcRect, &destRect);
+                SubmitSprite(texture, srcRect, destRect, 0.0, SDL_FLIP_NONE, color);
             }
 
-            // Check if a world rectangle is visible on screen (for culling)
+            // Check if a world rectangle is visible on screen (uses the cull margin, but
+            // answers even while culling is off)
             bool IsVisible(const Vector2<float>& worldPos, int width, int height) const {
                 if (!m_camera) return true;
 
                 Vector2<float> screenPos = m_camera->WorldToScreen(worldPos);
+                return IsOnScreen(screenPos.GetX(), screenPos.GetY(), static_cast<float>(width), static_cast<float>(height));
+            }
+
+        private:
+            bool IsOnScreen(float x, float y, float width, float height) const {
                 Vector2<float> camSize = m_camera->GetSize();
+                return x + width > -m_cullMargin &&
+                       x < camSize.GetX() + m_cullMargin &&
+                       y + height > -m_cullMargin &&
+                       y < camSize.GetY() + m_cullMargin;
+            }
 
-                return screenPos.GetX() + width > 0 &&
-                       screenPos.GetX() < camSize.GetX() &&
-                       screenPos.GetY() + height > 0 &&
-                       screenPos.GetY() < camSize.GetY();
+            // Whether a world-space draw, already moved to screen space, should be dropped
+            bool Cull(float x, float y, float width, float height) {
+                if (!m_culling || !m_camera || m_camera->GetSize().GetX() <= 0.0f) return false;
+                if (IsOnScreen(x, y, width, height)) return false;
+                m_stats.culled++;
+                return true;
+            }
+
+            void SubmitSprite(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect,
+                              double angle, SDL_RendererFlip flip, const Color& color) {
+                if (!texture) return;
+                m_stats.submitted++;
+                if (!IsRecording()) {
+                    CopyTexture(texture, srcRect, destRect, angle, flip, SDL_Color{ color.r, color.g, color.b, color.a });
+                    return;
+                }
+
+                DrawQueue::Command command;
+                command.type = DrawQueue::CommandType::Sprite;
+                command.texture = texture;
+                command.hasSource = srcRect != nullptr;
+                if (srcRect) command.source = *srcRect;
+                command.dest = destRect;
+                command.angle = angle;
+                command.flip = flip;
+                command.color = SDL_Color{ color.r, color.g, color.b, color.a };
+                SDL_GetTextureBlendMode(texture, &command.blend);
+                m_queue.Add(command, m_renderLayer, m_renderLayerYSorted,
+                            static_cast<float>(destRect.y + destRect.h));
+            }
+
+            // Rects use dest as x, y, w, h; lines as x1, y1, x2, y2; points as x, y
+            void SubmitShape(DrawQueue::CommandType type, const SDL_Rect& dest) {
+                m_stats.submitted++;
+                if (IsRecording()) {
+                    RecordShape(type, dest);
+                    return;
+                }
+
+                DrawQueue::Command command;
+                command.type = type;
+                command.dest = dest;
+                DrawShape(command);
+            }
+
+            void RecordShape(DrawQueue::CommandType type, const SDL_Rect& dest) {
+                DrawQueue::Command command;
+                command.type = type;
+                command.dest = dest;
+                command.color = m_drawColor;
+                command.blend = m_blendMode;
+
+                float sortY = static_cast<float>(dest.y);
+                if (type == DrawQueue::CommandType::FilledRect || type == DrawQueue::CommandType::Rect) {
+                    sortY += dest.h;
+                } else if (type == DrawQueue::CommandType::Line) {
+                    sortY = static_cast<float>(std::max(dest.y, dest.h));
+                }
+                m_queue.Add(command, m_renderLayer, m_renderLayerYSorted, sortY);
+            }
+
+            // Sort what the pass recorded and draw it, putting the draw color and blend mode
+            // back afterwards
+            void SubmitQueue() {
+                m_passDepth = 0;
+                if (!m_queue.IsEmpty()) ReplayQueue();
+
+                // Recorded draws may refer to these, so they go only after the replay
+                Flush();
+                for (SDL_Texture* texture : m_pendingDestroys) {
+                    SDL_DestroyTexture(texture);
+                }
+                m_pendingDestroys.clear();
+            }
+
+            void ReplayQueue() {
+                m_stats.sortedCommands += m_queue.Count();
+                m_stats.textureSwitchesUnsorted += m_queue.CountTextureSwitches();
+                m_queue.Sort();
+                m_stats.textureSwitchesSorted += m_queue.CountTextureSwitches();
+
+                SDL_Color color = m_drawColor;
+                SDL_BlendMode blendMode = m_blendMode;
+                m_queue.ForEach([this, &color, &blendMode](const DrawQueue::Command& command) {
+                    if (command.type == DrawQueue::CommandType::Sprite) {
+                        CopyTexture(command.texture, command.hasSource ? &command.source : nullptr,
+                                    command.dest, command.angle, command.flip, command.color);
+                        return;
+                    }
+                    if (!SameColor(command.color, color)) {
+                        color = command.color;
+                        SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b, color.a);
+                    }
+                    if (command.blend != blendMode) {
+                        blendMode = command.blend;
+                        SDL_SetRenderDrawBlendMode(m_sdlRenderer, blendMode);
+                    }
+                    DrawShape(command);
+                });
+                m_queue.Clear();
+
+                if (!SameColor(color, m_drawColor)) {
+                    SDL_SetRenderDrawColor(m_sdlRenderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
+                }
+                if (blendMode != m_blendMode) {
+                    SDL_SetRenderDrawBlendMode(m_sdlRenderer, m_blendMode);
+                }
+            }
+
+            void DrawRectangles(DrawQueue::CommandType type, const Rectangle<float>* rects, size_t count) {
+                m_rectScratch.clear();
+                for (size_t i = 0; i < count; i++) {
+                    Vector2<float> screenPos = WorldToScreen(rects[i].GetPosition());
+                    Vector2<float> size = rects[i].GetSize();
+                    if (Cull(screenPos.GetX(), screenPos.GetY(), size.GetX(), size.GetY())) continue;
+                    m_rectScratch.push_back({
+                        static_cast<int>(screenPos.GetX()),
+                        static_cast<int>(screenPos.GetY()),
+                        static_cast<int>(size.GetX()),
+                        static_cast<int>(size.GetY())
+                    });
+                }
+                if (m_rectScratch.empty()) return;
+
+                m_stats.submitted += m_rectScratch.size();
+                if (IsRecording()) {
+                    for (const SDL_Rect& rect : m_rectScratch) {
+                        RecordShape(type, rect);
+                    }
+                    return;
+                }
+                Flush();
+                int rectCount = static_cast<int>(m_rectScratch.size());
+                if (type == DrawQueue::CommandType::FilledRect) {
+                    SDL_RenderFillRects(m_sdlRenderer, m_rectScratch.data(), rectCount);
+                } else {
+                    SDL_RenderDrawRects(m_sdlRenderer, m_rectScratch.data(), rectCount);
+                }
+            }
+
+            void DrawShape(const DrawQueue::Command& command) {
+                Flush();
+                const SDL_Rect& dest = command.dest;
+                switch (command.type) {
+                    case DrawQueue::CommandType::FilledRect:
+                        SDL_RenderFillRect(m_sdlRenderer, &dest);
+                        break;
+                    case DrawQueue::CommandType::Rect:
+                        SDL_RenderDrawRect(m_sdlRenderer, &dest);
+                        break;
+                    case DrawQueue::CommandType::Line:
+                        SDL_RenderDrawLine(m_sdlRenderer, dest.x, dest.y, dest.w, dest.h);
+                        break;
+                    case DrawQueue::CommandType::Point:
+                        SDL_RenderDrawPoint(m_sdlRenderer, dest.x, dest.y);
+                        break;
+                    case DrawQueue::CommandType::Sprite:
+                        break;
+                }
+            }
+
+            static bool SameColor(const SDL_Color& a, const SDL_Color& b) {
+                return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+            }
+
+            void CopyTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect,
+                             double angle, SDL_RendererFlip flip, const SDL_Color& color) {
+                if (m_batching) {
+                    if (texture != m_batch.GetTexture()) {
+                        Flush();
+                        int textureWidth = 0, textureHeight = 0;
+                        SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+                        m_batch.Begin(texture, textureWidth, textureHeight);
+                    }
+                    m_batch.AddQuad(srcRect, destRect, angle, flip, color);
+                    return;
+                }
+
+                // Modulation is texture state, so put it back for the next user of the texture
+                bool tinted = !SameColor(color, SDL_Color{ 255, 255, 255, 255 });
+                if (tinted) {
+                    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+                    SDL_SetTextureAlphaMod(texture, color.a);
+                }
+                if (angle == 0.0 && flip == SDL_FLIP_NONE) {
+                    SDL_RenderCopy(m_sdlRenderer, texture, srcRect, &destRect);
+                } else {
+                    SDL_RenderCopyEx(m_sdlRenderer, texture, srcRect, &destRect, angle, nullptr, flip);
+                }
+                if (tinted) {
+                    SDL_SetTextureColorMod(texture, 255, 255, 255);
+                    SDL_SetTextureAlphaMod(texture, 255);
+                }
             }
 
-        private:
             Vector2<float> WorldToScreen(const Vector2<float>& worldPos) const {
                 if (m_camera) {
                     return m_camera->WorldToScreen(worldPos);
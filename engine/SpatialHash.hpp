@@ -0,0 +1,162 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+#include "engine/AABB.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Uniform grid of square cells hashed into a fixed number of buckets.
+    // Each entry is stored in every bucket its cell range maps to. Unrelated cells can share
+    // a bucket, so a query returns a superset of the real neighbours (and may repeat ids) -
+    // callers dedupe and run an exact test afterwards. Entries spanning more cells than
+    // there are buckets go in a separate list every query reports, and queries that large
+    // scan the buckets once each instead of walking cells.
+    class SpatialHash {
+    public:
+        struct CellRange {
+            int minX = 0;
+            int minY = 0;
+            int maxX = -1; // Empty until set
+            int maxY = -1;
+
+            bool IsEmpty() const { return maxX < minX || maxY < minY; }
+            bool operator==(const CellRange& rhs) const {
+                return minX == rhs.minX && minY == rhs.minY && maxX == rhs.maxX && maxY == rhs.maxY;
+            }
+            bool operator!=(const CellRange& rhs) const { return !(*this == rhs); }
+        };
+
+    private:
+        float m_cellSize;
+        float m_invCellSize;
+        std::vector<std::vector<uint32_t>> m_buckets;
+        std::vector<uint32_t> m_oversized;
+        uint32_t m_bucketMask;
+
+    public:
+        // bucketCount is rounded up to a power of two
+        explicit SpatialHash(float cellSize = 64.0f, size_t bucketCount = 4096) {
+            size_t count = 1;
+            while (count < bucketCount) count <<= 1;
+            m_buckets.resize(count);
+            m_bucketMask = static_cast<uint32_t>(count - 1);
+            SetCellSize(cellSize);
+        }
+
+        // Changing the cell size invalidates every stored range - clear and re-insert
+        void SetCellSize(float cellSize) {
+            m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+            m_invCellSize = 1.0f / m_cellSize;
+        }
+
+        float GetCellSize() const { return m_cellSize; }
+
+        // Cell coordinates are clamped to +-MaxCell (in float, before converting), so huge,
+        // far-off or NaN bounds can't overflow
+        static constexpr float MaxCell = 16777216.0f; // 2^24
+
+        CellRange GetCellRange(const AABB& bounds) const {
+            CellRange range;
+            range.minX = CellIndex(bounds.minX);
+            range.minY = CellIndex(bounds.minY);
+            range.maxX = CellIndex(bounds.maxX);
+            range.maxY = CellIndex(bounds.maxY);
+            return range;
+        }
+
+        void Insert(uint32_t id, const CellRange& range) {
+            if (IsOversized(range)) {
+                m_oversized.push_back(id);
+                return;
+            }
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int x = range.minX; x <= range.maxX; x++) {
+                    m_buckets[Hash(x, y)].push_back(id);
+                }
+            }
+        }
+
+        // Must be given the same range the id was inserted with
+        void Remove(uint32_t id, const CellRange& range) {
+            if (IsOversized(range)) {
+                RemoveFrom(m_oversized, id);
+                return;
+            }
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int x = range.minX; x <= range.maxX; x++) {
+                    RemoveFrom(m_buckets[Hash(x, y)], id);
+                }
+            }
+        }
+
+        // Re-bucket only if the cell range changed - moves within a cell cost nothing
+        void Move(uint32_t id, const CellRange& oldRange, const CellRange& newRange) {
+            if (oldRange == newRange) return;
+            Remove(id, oldRange);
+            Insert(id, newRange);
+        }
+
+        // Call fn(id) for every entry in the buckets covering range (may repeat ids)
+        template<typename Fn>
+        void Query(const CellRange& range, Fn&& fn) const {
+            if (range.IsEmpty()) return;
+            for (uint32_t id : m_oversized) {
+                fn(id);
+            }
+            if (IsOversized(range)) {
+                for (const auto& bucket : m_buckets) {
+                    for (uint32_t id : bucket) {
+                        fn(id);
+                    }
+                }
+                return;
+            }
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int x = range.minX; x <= range.maxX; x++) {
+                    for (uint32_t id : m_buckets[Hash(x, y)]) {
+                        fn(id);
+                    }
+                }
+            }
+        }
+
+        void Clear() {
+            for (auto& bucket : m_buckets) {
+                bucket.clear();
+            }
+            m_oversized.clear();
+        }
+
+    private:
+        int CellIndex(float coordinate) const {
+            float cell = std::floor(coordinate * m_invCellSize);
+            if (!(cell >= -MaxCell)) return static_cast<int>(-MaxCell); // Also catches NaN
+            return static_cast<int>(cell > MaxCell ? MaxCell : cell);
+        }
+
+        // More cells than buckets - walking the cells would visit some buckets repeatedly
+        bool IsOversized(const CellRange& range) const {
+            if (range.IsEmpty()) return false;
+            uint64_t width = static_cast<uint64_t>(static_cast<int64_t>(range.maxX) - range.minX + 1);
+            uint64_t height = static_cast<uint64_t>(static_cast<int64_t>(range.maxY) - range.minY + 1);
+            return width * height > m_buckets.size();
+        }
+
+        static void RemoveFrom(std::vector<uint32_t>& ids, uint32_t id) {
+            for (size_t i = 0; i < ids.size(); i++) {
+                if (ids[i] == id) {
+                    ids[i] = ids.back();
+                    ids.pop_back();
+                    break;
+                }
+            }
+        }
+
+        uint32_t Hash(int x, int y) const {
+            uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+            return h & m_bucketMask;
+        }
+    };
+}
+#endif
@@ -14,6 +14,7 @@ namespace Engine {
         Vector2i m_sheetSize;            // size of sprite sheet in columns and rows
         Vector2i m_currentFrame;         // current column/row in sprite sheet
         SDL_RendererFlip m_flip = SDL_FLIP_NONE;
+        Color m_color = Color::White();  // tint multiplied into the texture
 
     public:
         Sprite() = default;
@@ -89,6 +90,10 @@ namespace Engine {
         bool IsFlippedHorizontal() const { return m_flip & SDL_FLIP_HORIZONTAL; }
         bool IsFlippedVertical() const { return m_flip & SDL_FLIP_VERTICAL; }
 
+        // Color modulation (white draws the texture unchanged, alpha fades it)
+        void SetColor(const Color& color) { m_color = color; }
+        const Color& GetColor() const { return m_color; }
+
         // Get source rectangle for current frame
         SDL_Rect GetSourceRect() const {
             return {
@@ -104,10 +109,10 @@ namespace Engine {
             SDL_Rect srcRect = GetSourceRect();
             if (m_flip == SDL_FLIP_NONE) {
                 renderer.DrawSprite(m_texture, &srcRect, position,
-                                   m_spriteSize.GetX(), m_spriteSize.GetY());
+                                   m_spriteSize.GetX(), m_spriteSize.GetY(), m_color);
             } else {
                 renderer.DrawSpriteEx(m_texture, &srcRect, position,
-                                     m_spriteSize.GetX(), m_spriteSize.GetY(), 0.0, m_flip);
+                                     m_spriteSize.GetX(), m_spriteSize.GetY(), 0.0, m_flip, m_color);
             }
         }
 
@@ -115,9 +120,9 @@ namespace Engine {
         void Draw(Renderer& renderer, const Vector2f& position, int width, int height) {
             SDL_Rect srcRect = GetSourceRect();
             if (m_flip == SDL_FLIP_NONE) {
-                renderer.DrawSprite(m_texture, &srcRect, position, width, height);
+                renderer.DrawSprite(m_texture, &srcRect, position, width, height, m_color);
             } else {
-                renderer.DrawSpriteEx(m_texture, &srcRect, position, width, height, 0.0, m_flip);
+                renderer.DrawSpriteEx(m_texture, &srcRect, position, width, height, 0.0, m_flip, m_color);
             }
         }
 
@@ -125,7 +130,7 @@ namespace Engine {
         void Draw(Renderer& renderer, const Vector2f& position, double angle) {
             SDL_Rect srcRect = GetSourceRect();
             renderer.DrawSpriteEx(m_texture, &srcRect, position,
-                                 m_spriteSize.GetX(), m_spriteSize.GetY(), angle, m_flip);
+                                 m_spriteSize.GetX(), m_spriteSize.GetY(), angle, m_flip, m_color);
         }
 
         // Getters
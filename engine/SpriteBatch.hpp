@@ -0,0 +1,103 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+    // Textured quads for one texture, laid out for SDL_RenderGeometry: four vertices and six
+    // indices per quad. Renderer fills it while consecutive sprites share a texture and
+    // submits the whole run in one call. Buffers keep their capacity across Clear, so a
+    // steady frame allocates nothing.
+    class SpriteBatch {
+    private:
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int> m_indices;
+        SDL_Texture* m_texture = nullptr;
+        float m_invTextureWidth = 1.0f;
+        float m_invTextureHeight = 1.0f;
+        int m_textureWidth = 0;
+        int m_textureHeight = 0;
+
+    public:
+        // Start a run for texture (textureWidth/Height in pixels, used to turn source rects
+        // into texture coordinates). Anything already queued is dropped - flush it first.
+        void Begin(SDL_Texture* texture, int textureWidth, int textureHeight) {
+            Clear();
+            m_texture = texture;
+            m_textureWidth = textureWidth;
+            m_textureHeight = textureHeight;
+            m_invTextureWidth = textureWidth > 0 ? 1.0f / textureWidth : 1.0f;
+            m_invTextureHeight = textureHeight > 0 ? 1.0f / textureHeight : 1.0f;
+        }
+
+        // Queue a quad the way SDL_RenderCopyEx would draw it: srcRect (nullptr for the whole
+        // texture) stretched over destRect, flipped, then rotated angle degrees clockwise about
+        // the centre of destRect. color modulates every texel.
+        void AddQuad(const SDL_Rect* srcRect, const SDL_Rect& destRect, double angle,
+                     SDL_RendererFlip flip, const SDL_Color& color) {
+            float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+            if (srcRect) {
+                u0 = srcRect->x * m_invTextureWidth;
+                v0 = srcRect->y * m_invTextureHeight;
+                u1 = (srcRect->x + srcRect->w) * m_invTextureWidth;
+                v1 = (srcRect->y + srcRect->h) * m_invTextureHeight;
+            }
+            if (flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+            if (flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+            // Corners relative to the centre, clockwise from top-left
+            float halfW = destRect.w * 0.5f;
+            float halfH = destRect.h * 0.5f;
+            float centreX = destRect.x + halfW;
+            float centreY = destRect.y + halfH;
+            float cornersX[4] = { -halfW, halfW, halfW, -halfW };
+            float cornersY[4] = { -halfH, -halfH, halfH, halfH };
+            float us[4] = { u0, u1, u1, u0 };
+            float vs[4] = { v0, v0, v1, v1 };
+
+            float c = 1.0f, s = 0.0f;
+            if (angle != 0.0) {
+                double radians = angle * 3.14159265358979323846 / 180.0;
+                c = static_cast<float>(std::cos(radians));
+                s = static_cast<float>(std::sin(radians));
+            }
+
+            int base = static_cast<int>(m_vertices.size());
+            for (int i = 0; i < 4; i++) {
+                SDL_Vertex vertex;
+                vertex.position.x = centreX + cornersX[i] * c - cornersY[i] * s;
+                vertex.position.y = centreY + cornersX[i] * s + cornersY[i] * c;
+                vertex.color = color;
+                vertex.tex_coord.x = us[i];
+                vertex.tex_coord.y = vs[i];
+                m_vertices.push_back(vertex);
+            }
+            const int quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int index : quadIndices) {
+                m_indices.push_back(base + index);
+            }
+        }
+
+        // Forget the queued quads and the texture, keeping the buffers
+        void Clear() {
+            m_vertices.clear();
+            m_indices.clear();
+            m_texture = nullptr;
+        }
+
+        bool IsEmpty() const { return m_vertices.empty(); }
+        size_t QuadCount() const { return m_vertices.size() / 4; }
+
+        SDL_Texture* GetTexture() const { return m_texture; }
+        int GetTextureWidth() const { return m_textureWidth; }
+        int GetTextureHeight() const { return m_textureHeight; }
+
+        const SDL_Vertex* GetVertices() const { return m_vertices.data(); }
+        int GetVertexCount() const { return static_cast<int>(m_vertices.size()); }
+        const int* GetIndices() const { return m_indices.data(); }
+        int GetIndexCount() const { return static_cast<int>(m_indices.size()); }
+    };
+}
+#endif
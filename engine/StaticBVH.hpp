@@ -0,0 +1,120 @@
+#ifndef STATIC_BVH_H
+#define STATIC_BVH_H
+#include "engine/AABB.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Bounding volume hierarchy built once over boxes that never move. Built top-down by
+    // splitting at the median centre along the longer axis, and stored depth-first in one
+    // array: a node's first child is the next node, so queries walk memory mostly forwards.
+    // Nothing can be moved or removed - rebuild it instead.
+    class StaticBVH {
+    public:
+        struct Entry {
+            AABB bounds;
+            uint32_t userData;
+        };
+
+        static constexpr uint32_t LeafSize = 4; // Entries tested per leaf instead of splitting further
+
+    private:
+        struct Node {
+            AABB bounds;
+            uint32_t start = 0;      // First entry (leaves only)
+            uint32_t count = 0;      // Entries in the leaf, 0 for an inner node
+            uint32_t secondChild = 0; // Inner nodes only - the first child is this node + 1
+        };
+
+        std::vector<Node> m_nodes;
+        std::vector<Entry> m_entries; // Reordered so every leaf's entries are contiguous
+
+    public:
+        // Replace the contents with entries
+        void Build(std::vector<Entry> entries) {
+            m_entries = std::move(entries);
+            m_nodes.clear();
+            if (m_entries.empty()) return;
+            m_nodes.reserve(2 * (m_entries.size() / LeafSize + 1));
+            BuildNode(0, static_cast<uint32_t>(m_entries.size()));
+        }
+
+        // Call fn(userData) for every entry whose box overlaps bounds (touching counts)
+        template<typename Fn>
+        void Query(const AABB& bounds, Fn&& fn) const {
+            if (m_nodes.empty()) return;
+
+            // Borrow this thread's stack (a nested query from fn gets a fresh one)
+            std::vector<uint32_t> stack;
+            stack.swap(StackBuffer());
+            stack.push_back(0);
+            while (!stack.empty()) {
+                const Node& node = m_nodes[stack.back()];
+                uint32_t index = stack.back();
+                stack.pop_back();
+                if (!node.bounds.Overlaps(bounds)) continue;
+                if (node.count) {
+                    for (uint32_t i = node.start; i < node.start + node.count; i++) {
+                        if (m_entries[i].bounds.Overlaps(bounds)) fn(m_entries[i].userData);
+                    }
+                } else {
+                    stack.push_back(node.secondChild);
+                    stack.push_back(index + 1);
+                }
+            }
+            StackBuffer().swap(stack);
+        }
+
+        void Clear() {
+            m_nodes.clear();
+            m_entries.clear();
+        }
+
+        size_t Count() const { return m_entries.size(); }
+        size_t NodeCount() const { return m_nodes.size(); }
+
+    private:
+        static std::vector<uint32_t>& StackBuffer() {
+            static thread_local std::vector<uint32_t> stack;
+            return stack;
+        }
+
+        uint32_t BuildNode(uint32_t start, uint32_t end) {
+            uint32_t index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+
+            AABB bounds = m_entries[start].bounds;
+            AABB centres(CentreX(m_entries[start]), CentreY(m_entries[start]),
+                         CentreX(m_entries[start]), CentreY(m_entries[start]));
+            for (uint32_t i = start + 1; i < end; i++) {
+                bounds = AABB::Union(bounds, m_entries[i].bounds);
+                float x = CentreX(m_entries[i]);
+                float y = CentreY(m_entries[i]);
+                centres = AABB::Union(centres, AABB(x, y, x, y));
+            }
+            m_nodes[index].bounds = bounds;
+
+            if (end - start <= LeafSize) {
+                m_nodes[index].start = start;
+                m_nodes[index].count = end - start;
+                return index;
+            }
+
+            uint32_t middle = start + (end - start) / 2;
+            bool splitX = centres.GetWidth() >= centres.GetHeight();
+            std::nth_element(m_entries.begin() + start, m_entries.begin() + middle, m_entries.begin() + end,
+                [splitX](const Entry& a, const Entry& b) {
+                    return splitX ? CentreX(a) < CentreX(b) : CentreY(a) < CentreY(b);
+                });
+            BuildNode(start, middle);
+            uint32_t second = BuildNode(middle, end);
+            m_nodes[index].secondChild = second; // m_nodes may have grown, so index again
+            return index;
+        }
+
+        static float CentreX(const Entry& entry) { return (entry.bounds.minX + entry.bounds.maxX) * 0.5f; }
+        static float CentreY(const Entry& entry) { return (entry.bounds.minY + entry.bounds.maxY) * 0.5f; }
+    };
+}
+#endif
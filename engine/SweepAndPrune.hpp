@@ -0,0 +1,225 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+#include "engine/AABB.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Persistent sweep-and-prune. Box endpoints are kept sorted on both axes across frames;
+    // when a box moves its endpoints are insertion-sorted into place, and every time two
+    // endpoints cross the pair is added or removed. With small per-frame motion only a few
+    // swaps happen, so the cost follows motion rather than the number of boxes.
+    class SweepAndPrune {
+    public:
+        struct PairEvent {
+            uint32_t a;
+            uint32_t b;
+            bool added; // false = stopped overlapping (or one of them was removed)
+        };
+
+    private:
+        struct Endpoint {
+            float value;
+            uint32_t id;
+            bool isMax;
+        };
+
+        struct Box {
+            AABB bounds;
+            uint32_t minIndex[2] = {0, 0}; // Position of each endpoint in m_axes
+            uint32_t maxIndex[2] = {0, 0};
+            std::vector<uint32_t> overlaps;
+            bool active = false;
+        };
+
+        std::vector<Endpoint> m_axes[2]; // 0 = X, 1 = Y
+        std::vector<Box> m_boxes;        // Indexed by id
+        std::vector<PairEvent> m_events;
+        size_t m_pairCount = 0;
+
+    public:
+        SweepAndPrune() = default;
+
+        // Add a box - O(n), overlaps with existing boxes are reported as added pairs
+        void Insert(uint32_t id, const AABB& bounds) {
+            if (id >= m_boxes.size()) {
+                m_boxes.resize(id + 1);
+            }
+            Box& box = m_boxes[id];
+            box.bounds = bounds;
+            box.active = true;
+            box.overlaps.clear();
+
+            for (int axis = 0; axis < 2; axis++) {
+                std::vector<Endpoint>& endpoints = m_axes[axis];
+                Endpoint minEndpoint{Lower(bounds, axis), id, false};
+                Endpoint maxEndpoint{Upper(bounds, axis), id, true};
+                auto minPos = std::upper_bound(endpoints.begin(), endpoints.end(), minEndpoint, Less);
+                size_t first = static_cast<size_t>(minPos - endpoints.begin());
+                endpoints.insert(minPos, minEndpoint);
+                auto maxPos = std::upper_bound(endpoints.begin() + first + 1, endpoints.end(), maxEndpoint, Less);
+                endpoints.insert(maxPos, maxEndpoint);
+                Reindex(axis, first);
+            }
+
+            for (uint32_t other = 0; other < m_boxes.size(); other++) {
+                if (other != id && m_boxes[other].active && m_boxes[other].bounds.Overlaps(bounds)) {
+                    AddPair(id, other);
+                }
+            }
+        }
+
+        // Remove a box - O(n), its pairs are reported as removed
+        void Remove(uint32_t id) {
+            Box& box = m_boxes[id];
+            while (!box.overlaps.empty()) {
+                RemovePair(id, box.overlaps.back());
+            }
+            for (int axis = 0; axis < 2; axis++) {
+                std::vector<Endpoint>& endpoints = m_axes[axis];
+                size_t first = box.minIndex[axis];
+                endpoints.erase(endpoints.begin() + box.maxIndex[axis]);
+                endpoints.erase(endpoints.begin() + first);
+                Reindex(axis, first);
+            }
+            box.active = false;
+        }
+
+        // Move a box to new bounds, emitting pair events for every endpoint it passes
+        void Move(uint32_t id, const AABB& bounds) {
+            Box& box = m_boxes[id];
+            AABB old = box.bounds;
+            if (old == bounds) return;
+            box.bounds = bounds;
+
+            for (int axis = 0; axis < 2; axis++) {
+                // Move the leading endpoint first so a box never passes its own other end
+                bool growing = Upper(bounds, axis) > Upper(old, axis);
+                if (growing) {
+                    UpdateEndpoint(axis, box.maxIndex[axis], Upper(bounds, axis));
+                    UpdateEndpoint(axis, box.minIndex[axis], Lower(bounds, axis));
+                } else {
+                    UpdateEndpoint(axis, box.minIndex[axis], Lower(bounds, axis));
+                    UpdateEndpoint(axis, box.maxIndex[axis], Upper(bounds, axis));
+                }
+            }
+        }
+
+        // Call fn(otherId) for every box currently overlapping id
+        template<typename Fn>
+        void ForEachOverlap(uint32_t id, Fn&& fn) const {
+            for (uint32_t other : m_boxes[id].overlaps) {
+                fn(other);
+            }
+        }
+
+        // Pair changes since the last ClearEvents
+        const std::vector<PairEvent>& GetEvents() const { return m_events; }
+        void ClearEvents() { m_events.clear(); }
+
+        size_t GetPairCount() const { return m_pairCount; }
+
+        void Clear() {
+            m_axes[0].clear();
+            m_axes[1].clear();
+            m_boxes.clear();
+            m_events.clear();
+            m_pairCount = 0;
+        }
+
+    private:
+        static float Lower(const AABB& bounds, int axis) { return axis == 0 ? bounds.minX : bounds.minY; }
+        static float Upper(const AABB& bounds, int axis) { return axis == 0 ? bounds.maxX : bounds.maxY; }
+
+        // Min endpoints sort before max endpoints at equal values, so touching boxes
+        // count as overlapping - the same rule as AABB::Overlaps
+        static bool Less(const Endpoint& a, const Endpoint& b) {
+            return a.value < b.value || (a.value == b.value && !a.isMax && b.isMax);
+        }
+
+        void Reindex(int axis, size_t from) {
+            std::vector<Endpoint>& endpoints = m_axes[axis];
+            for (size_t i = from; i < endpoints.size(); i++) {
+                SetIndex(axis, i);
+            }
+        }
+
+        void SetIndex(int axis, size_t index) {
+            const Endpoint& endpoint = m_axes[axis][index];
+            Box& box = m_boxes[endpoint.id];
+            (endpoint.isMax ? box.maxIndex : box.minIndex)[axis] = static_cast<uint32_t>(index);
+        }
+
+        // Insertion-sort one endpoint to its new value. A min passing a max (or a max passing
+        // a min) is where two boxes start or stop overlapping on this axis; starts are only
+        // kept if the boxes' final bounds overlap on both axes.
+        void UpdateEndpoint(int axis, size_t index, float value) {
+            std::vector<Endpoint>& endpoints = m_axes[axis];
+            endpoints[index].value = value;
+
+            while (index > 0 && Less(endpoints[index], endpoints[index - 1])) {
+                const Endpoint& moving = endpoints[index];
+                const Endpoint& other = endpoints[index - 1];
+                if (moving.id != other.id) {
+                    if (!moving.isMax && other.isMax) {
+                        TryAddPair(moving.id, other.id);
+                    } else if (moving.isMax && !other.isMax) {
+                        RemovePair(moving.id, other.id);
+                    }
+                }
+                std::swap(endpoints[index], endpoints[index - 1]);
+                SetIndex(axis, index);
+                SetIndex(axis, index - 1);
+                index--;
+            }
+
+            while (index + 1 < endpoints.size() && Less(endpoints[index + 1], endpoints[index])) {
+                const Endpoint& moving = endpoints[index];
+                const Endpoint& other = endpoints[index + 1];
+                if (moving.id != other.id) {
+                    if (moving.isMax && !other.isMax) {
+                        TryAddPair(moving.id, other.id);
+                    } else if (!moving.isMax && other.isMax) {
+                        RemovePair(moving.id, other.id);
+                    }
+                }
+                std::swap(endpoints[index], endpoints[index + 1]);
+                SetIndex(axis, index);
+                SetIndex(axis, index + 1);
+                index++;
+            }
+        }
+
+        void TryAddPair(uint32_t a, uint32_t b) {
+            if (m_boxes[a].bounds.Overlaps(m_boxes[b].bounds)) {
+                AddPair(a, b);
+            }
+        }
+
+        void AddPair(uint32_t a, uint32_t b) {
+            std::vector<uint32_t>& overlaps = m_boxes[a].overlaps;
+            if (std::find(overlaps.begin(), overlaps.end(), b) != overlaps.end()) return;
+            overlaps.push_back(b);
+            m_boxes[b].overlaps.push_back(a);
+            m_events.push_back({a, b, true});
+            m_pairCount++;
+        }
+
+        void RemovePair(uint32_t a, uint32_t b) {
+            if (!Erase(m_boxes[a].overlaps, b)) return;
+            Erase(m_boxes[b].overlaps, a);
+            m_events.push_back({a, b, false});
+            m_pairCount--;
+        }
+
+        static bool Erase(std::vector<uint32_t>& ids, uint32_t id) {
+            auto it = std::find(ids.begin(), ids.end(), id);
+            if (it == ids.end()) return false;
+            *it = ids.back();
+            ids.pop_back();
+            return true;
+        }
+    };
+}
+#endif
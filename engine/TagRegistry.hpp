@@ -0,0 +1,101 @@
+#ifndef TAG_REGISTRY_H
+#define TAG_REGISTRY_H
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+    // Interned tag - index of a bit in a TagMask
+    using TagId = uint8_t;
+    using TagMask = uint64_t;
+
+    // Global registry mapping tag strings to small integer IDs.
+    // Intern once (e.g. into a static or member), then use the TagId overloads so
+    // membership tests are a single AND instead of a string compare.
+    class TagRegistry {
+    public:
+        static constexpr size_t MaxTags = 64;
+        static constexpr TagId InvalidTag = 0xFF;
+
+        // Get the ID for a tag, registering it on first use (InvalidTag once all 64 are taken)
+        static TagId Intern(const std::string& name) {
+            TagId id = TryIntern(name);
+            if (id == InvalidTag) {
+                std::cout << "warn: tag limit of " << MaxTags << " reached, ignoring tag: " << name << std::endl;
+            }
+            return id;
+        }
+
+        // Look up a tag without registering it (InvalidTag if never interned)
+        static TagId Find(const std::string& name) {
+            TagRegistry& registry = Instance();
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            auto it = registry.m_ids.find(name);
+            return it != registry.m_ids.end() ? it->second : InvalidTag;
+        }
+
+        static std::string GetName(TagId id) {
+            TagRegistry& registry = Instance();
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            return id < registry.m_names.size() ? registry.m_names[id] : std::string();
+        }
+
+        static TagMask ToMask(TagId id) {
+            return id < MaxTags ? (TagMask(1) << id) : 0;
+        }
+
+        // Call fn(TagId) for every bit set in mask, lowest first
+        template<typename Fn>
+        static void ForEachTag(TagMask mask, Fn&& fn) {
+            while (mask) {
+                fn(static_cast<TagId>(CountTrailingZeros(mask)));
+                mask &= mask - 1;
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<std::string, TagId> m_ids;
+        std::vector<std::string> m_names;
+
+        TagRegistry() = default;
+
+        static TagRegistry& Instance() {
+            static TagRegistry registry;
+            return registry;
+        }
+
+        static TagId TryIntern(const std::string& name) {
+            TagRegistry& registry = Instance();
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            auto it = registry.m_ids.find(name);
+            if (it != registry.m_ids.end()) {
+                return it->second;
+            }
+            if (registry.m_names.size() >= MaxTags) {
+                return InvalidTag;
+            }
+            TagId id = static_cast<TagId>(registry.m_names.size());
+            registry.m_names.push_back(name);
+            registry.m_ids.emplace(name, id);
+            return id;
+        }
+
+        static int CountTrailingZeros(TagMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(mask);
+#else
+            int count = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                count++;
+            }
+            return count;
+#endif
+        }
+    };
+}
+#endif
@@ -92,7 +92,7 @@ namespace Engine {
         // Draw at world position (uses camera)
         void Draw(Renderer* renderer, const Vector2<float>& worldPos) {
             if (!renderer) return;
-            UpdateTexture();
+            UpdateTexture(renderer);
             if (!m_texture) return;
 
             renderer->DrawSprite(m_texture, nullptr, worldPos, m_width, m_height);
@@ -105,7 +105,7 @@ namespace Engine {
         // Draw at screen position (ignores camera)
         void DrawScreen(Renderer* renderer, int x, int y) {
             if (!renderer) return;
-            UpdateTexture();
+            UpdateTexture(renderer);
             if (!m_texture) return;
 
             renderer->DrawSpriteScreen(m_texture, nullptr, x, y, m_width, m_height);
@@ -124,7 +124,8 @@ namespace Engine {
             DrawScreen(renderer, x - m_width / 2, y - m_height / 2);
         }
 
-        // Free resources
+        // Free resources (outside drawing - a renderer may still have the texture queued
+        // until it is flushed or its sorted pass ends)
         void Free() {
             if (m_texture) {
                 SDL_DestroyTexture(m_texture);
@@ -139,11 +140,13 @@ namespace Engine {
         }
 
     private:
-        void UpdateTexture() {
+        // The old texture may still be queued by renderer (in a sprite batch or a sorted
+        // pass), so it is released through the renderer rather than destroyed here
+        void UpdateTexture(Renderer* renderer) {
             if (!m_dirty || !m_font || !m_sdlRenderer) return;
             if (m_text.empty()) {
                 if (m_texture) {
-                    SDL_DestroyTexture(m_texture);
+                    renderer->DestroyTexture(m_texture);
                     m_texture = nullptr;
                 }
                 m_width = 0;
@@ -154,7 +157,7 @@ namespace Engine {
 
             // Free old texture
             if (m_texture) {
-                SDL_DestroyTexture(m_texture);
+                renderer->DestroyTexture(m_texture);
                 m_texture = nullptr;
             }
 
@@ -0,0 +1,136 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+    // Fixed pool of worker threads for data-parallel loops.
+    // The calling thread joins in as worker 0, so a pool of N threads spawns N - 1.
+    class ThreadPool {
+    private:
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+
+        // Current job - only touched under m_mutex or while a job is running
+        std::function<void(size_t, size_t, size_t)> m_job;
+        size_t m_count = 0;
+        size_t m_chunkSize = 1;
+        std::atomic<size_t> m_nextChunk{0};
+        size_t m_activeWorkers = 0;
+        uint64_t m_generation = 0;
+        bool m_stop = false;
+
+        static int& WorkerIndexRef() {
+            static thread_local int index = -1;
+            return index;
+        }
+
+    public:
+        // threadCount = total threads including the caller (0 = hardware concurrency)
+        explicit ThreadPool(size_t threadCount = 0) {
+            if (threadCount == 0) {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            for (size_t i = 1; i < threadCount; i++) {
+                m_threads.emplace_back([this, i]() { WorkerLoop(i); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::thread& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t GetThreadCount() const { return m_threads.size() + 1; }
+
+        // Index of the calling thread within the running job (0..GetThreadCount()-1, 0 when the
+        // job runs inline), or -1 when called outside of ParallelFor
+        static int CurrentWorkerIndex() { return WorkerIndexRef(); }
+
+        // Split [0, count) into chunks and call fn(begin, end, workerIndex) for each chunk
+        // across the pool. Blocks until every chunk is done. Nested calls run inline.
+        template<typename Fn>
+        void ParallelFor(size_t count, size_t chunkSize, Fn&& fn) {
+            if (count == 0) return;
+            chunkSize = std::max<size_t>(1, chunkSize);
+
+            if (m_threads.empty() || count <= chunkSize || WorkerIndexRef() != -1) {
+                // Inline on the calling thread, which counts as worker 0 unless it already is one
+                int worker = WorkerIndexRef();
+                if (worker < 0) {
+                    WorkerIndexRef() = 0;
+                    fn(size_t(0), count, size_t(0));
+                    WorkerIndexRef() = -1;
+                } else {
+                    fn(size_t(0), count, static_cast<size_t>(worker));
+                }
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = [&fn](size_t begin, size_t end, size_t worker) { fn(begin, end, worker); };
+                m_count = count;
+                m_chunkSize = chunkSize;
+                m_nextChunk = 0;
+                m_activeWorkers = m_threads.size();
+                m_generation++;
+            }
+            m_wake.notify_all();
+
+            WorkerIndexRef() = 0;
+            RunChunks(0);
+            WorkerIndexRef() = -1;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_activeWorkers == 0; });
+            m_job = nullptr;
+        }
+
+    private:
+        void RunChunks(size_t worker) {
+            while (true) {
+                size_t begin = m_nextChunk.fetch_add(m_chunkSize);
+                if (begin >= m_count) break;
+                m_job(begin, std::min(begin + m_chunkSize, m_count), worker);
+            }
+        }
+
+        void WorkerLoop(size_t worker) {
+            WorkerIndexRef() = static_cast<int>(worker);
+            uint64_t seenGeneration = 0;
+            while (true) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+                if (m_stop) return;
+                seenGeneration = m_generation;
+                lock.unlock();
+
+                RunChunks(worker);
+
+                lock.lock();
+                if (--m_activeWorkers == 0) {
+                    m_done.notify_one();
+                }
+            }
+        }
+    };
+}
+#endif
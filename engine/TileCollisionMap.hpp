@@ -0,0 +1,196 @@
+#ifndef TILE_COLLISION_MAP_H
+#define TILE_COLLISION_MAP_H
+#include "engine/AABB.hpp"
+#include "engine/GameMeta.hpp"
+#include "engine/Rectangle.hpp"
+#include "engine/Vector2.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    // Solid tile met by TileCollisionMap::Sweep
+    struct TileHit {
+        int column = -1;
+        int row = -1;
+        uint8_t tile = 0;
+        float time = 1.0f;  // Fraction of the displacement travelled before touching (0-1)
+        Vector2f normal;    // Axis normal of the face that was hit, pointing back at the mover
+    };
+
+    // Level collision as a grid of tile values covering the world, 0 = empty and anything
+    // else solid (the value is free for the game, e.g. a tile type). Queries look only at the
+    // cells a box covers, so a 200x200 map costs the same per query as a 10x10 one and needs
+    // no collider per tile. Cell (0, 0) starts at the world origin.
+    class TileCollisionMap {
+    public:
+        static constexpr uint8_t Empty = 0;
+
+    private:
+        std::vector<uint8_t> m_tiles; // Row-major
+        int m_columns = 0;
+        int m_rows = 0;
+        float m_tileSize = 1.0f;
+        float m_invTileSize = 1.0f;
+        uint8_t m_outside = Empty;    // What cells past the edge of the map count as
+
+    public:
+        TileCollisionMap() = default;
+
+        TileCollisionMap(int columns, int rows, float tileSize) { Resize(columns, rows, tileSize); }
+
+        // Enough tiles to cover the world (a partial tile at the edge gets a whole cell)
+        TileCollisionMap(const GameMeta& meta, float tileSize) {
+            float size = tileSize > 0.0f ? tileSize : 1.0f;
+            Resize(static_cast<int>(std::ceil(meta.GetWorldWidth() / size)),
+                   static_cast<int>(std::ceil(meta.GetWorldHeight() / size)), size);
+        }
+
+        // Clears every tile
+        void Resize(int columns, int rows, float tileSize) {
+            m_columns = columns > 0 ? columns : 0;
+            m_rows = rows > 0 ? rows : 0;
+            m_tileSize = tileSize > 0.0f ? tileSize : 1.0f;
+            m_invTileSize = 1.0f / m_tileSize;
+            m_tiles.assign(static_cast<size_t>(m_columns) * m_rows, Empty);
+        }
+
+        int GetColumns() const { return m_columns; }
+        int GetRows() const { return m_rows; }
+        float GetTileSize() const { return m_tileSize; }
+
+        // Make the edge of the map solid (any non-zero value) so nothing can leave the world
+        void SetOutsideTile(uint8_t tile) { m_outside = tile; }
+        uint8_t GetOutsideTile() const { return m_outside; }
+
+        void SetTile(int column, int row, uint8_t tile) {
+            if (InBounds(column, row)) m_tiles[Index(column, row)] = tile;
+        }
+
+        uint8_t GetTile(int column, int row) const {
+            return InBounds(column, row) ? m_tiles[Index(column, row)] : m_outside;
+        }
+
+        bool IsSolid(int column, int row) const { return GetTile(column, row) != Empty; }
+
+        void Fill(uint8_t tile) { std::fill(m_tiles.begin(), m_tiles.end(), tile); }
+
+        // Cell holding a world position
+        Vector2i WorldToCell(const Vector2f& position) const {
+            return Vector2i(static_cast<int>(std::floor(position.GetX() * m_invTileSize)),
+                            static_cast<int>(std::floor(position.GetY() * m_invTileSize)));
+        }
+
+        // World-space box of a cell
+        Rectangle<float> GetCellRectangle(int column, int row) const {
+            return Rectangle<float>(Vector2f(column * m_tileSize, row * m_tileSize), Vector2f(m_tileSize, m_tileSize));
+        }
+
+        bool IsSolidAt(const Vector2f& position) const {
+            Vector2i cell = WorldToCell(position);
+            return IsSolid(cell.GetX(), cell.GetY());
+        }
+
+        // Whether the rectangle overlaps any solid tile (strict, like CollisionRectangle::IsColliding,
+        // so a box resting exactly on a floor isn't inside it)
+        bool Overlaps(const Rectangle<float>& rectangle) const {
+            bool hit = false;
+            ForEachSolidTile(AABB::FromRectangle(rectangle), [&hit](int, int, uint8_t) {
+                hit = true;
+                return false;
+            });
+            return hit;
+        }
+
+        // Call fn(column, row, tile) for every solid tile the rectangle overlaps, row by row.
+        // fn returns false to stop early.
+        template<typename Fn>
+        void ForEachOverlappingTile(const Rectangle<float>& rectangle, Fn&& fn) const {
+            ForEachSolidTile(AABB::FromRectangle(rectangle), fn);
+        }
+
+        // Move the box by displacement and find the first solid tile it would touch, visiting
+        // only the cells under the path's bounding box. Same rules as AABB::Sweep: sliding
+        // flush along tiles isn't a hit, and a box already inside a tile hits it at time 0
+        // with a zero normal. Ties go to the first tile in row order.
+        bool Sweep(const Rectangle<float>& box, const Vector2f& displacement, TileHit& hit) const {
+            hit = TileHit();
+            AABB start = AABB::FromRectangle(box);
+            const float dx = displacement.GetX();
+            const float dy = displacement.GetY();
+            AABB end(start.minX + dx, start.minY + dy, start.maxX + dx, start.maxY + dy);
+
+            // Inclusive cell range, so tiles the path only reaches at its very end are tested
+            AABB path = AABB::Union(start, end);
+            int minColumn = ClampFirstCell(std::floor(path.minX * m_invTileSize), m_columns);
+            int minRow = ClampFirstCell(std::floor(path.minY * m_invTileSize), m_rows);
+            int maxColumn = ClampLastCell(std::floor(path.maxX * m_invTileSize), m_columns);
+            int maxRow = ClampLastCell(std::floor(path.maxY * m_invTileSize), m_rows);
+            bool found = false;
+            for (int row = minRow; row <= maxRow; row++) {
+                for (int column = minColumn; column <= maxColumn; column++) {
+                    uint8_t tile = GetTile(column, row);
+                    if (tile == Empty) continue;
+                    AABB cell(column * m_tileSize, row * m_tileSize, (column + 1) * m_tileSize, (row + 1) * m_tileSize);
+                    float time, normalX, normalY;
+                    if (start.Sweep(cell, dx, dy, time, normalX, normalY) && (!found || time < hit.time)) {
+                        found = true;
+                        hit.column = column;
+                        hit.row = row;
+                        hit.tile = tile;
+                        hit.time = time;
+                        hit.normal = Vector2f(normalX, normalY);
+                    }
+                }
+            }
+            return found;
+        }
+
+    private:
+        bool InBounds(int column, int row) const {
+            return column >= 0 && row >= 0 && column < m_columns && row < m_rows;
+        }
+
+        size_t Index(int column, int row) const {
+            return static_cast<size_t>(row) * m_columns + column;
+        }
+
+        // A cell range along an axis with count cells, from unclamped float cell coordinates.
+        // Clamped before converting to int, so huge or far-off boxes neither overflow nor
+        // loop over cells that can't matter: to the map when the outside is empty, or to one
+        // cell past each edge when it's solid (every cell out there is the same tile).
+        int ClampFirstCell(float cell, int count) const {
+            float low = m_outside == Empty ? 0.0f : -1.0f;
+            return static_cast<int>(ClampCell(cell, low, static_cast<float>(count)));
+        }
+
+        int ClampLastCell(float cell, int count) const {
+            float high = static_cast<float>(m_outside == Empty ? count - 1 : count);
+            return static_cast<int>(ClampCell(cell, -1.0f, high));
+        }
+
+        // NaN ends up at low
+        static float ClampCell(float cell, float low, float high) {
+            if (!(cell >= low)) return low;
+            return cell > high ? high : cell;
+        }
+
+        template<typename Fn>
+        void ForEachSolidTile(const AABB& bounds, Fn&& fn) const {
+            // Cells a box strictly overlaps: the last one is the cell holding maxX unless maxX
+            // sits exactly on a cell edge
+            int minColumn = ClampFirstCell(std::floor(bounds.minX * m_invTileSize), m_columns);
+            int minRow = ClampFirstCell(std::floor(bounds.minY * m_invTileSize), m_rows);
+            int maxColumn = ClampLastCell(std::ceil(bounds.maxX * m_invTileSize) - 1.0f, m_columns);
+            int maxRow = ClampLastCell(std::ceil(bounds.maxY * m_invTileSize) - 1.0f, m_rows);
+            for (int row = minRow; row <= maxRow; row++) {
+                for (int column = minColumn; column <= maxColumn; column++) {
+                    uint8_t tile = GetTile(column, row);
+                    if (tile != Empty && !fn(column, row, tile)) return;
+                }
+            }
+        }
+    };
+}
+#endif
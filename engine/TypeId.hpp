@@ -0,0 +1,23 @@
+#ifndef TYPE_ID_H
+#define TYPE_ID_H
+#include <atomic>
+#include <cstdint>
+
+namespace Engine {
+    // Small dense integer per C++ type, usable as a vector index (no RTTI or hashing)
+    using TypeId = uint32_t;
+
+    namespace detail {
+        inline TypeId NextTypeId() {
+            static std::atomic<TypeId> next{0};
+            return next++;
+        }
+    }
+
+    template<typename T>
+    TypeId GetTypeId() {
+        static const TypeId id = detail::NextTypeId();
+        return id;
+    }
+}
+#endif
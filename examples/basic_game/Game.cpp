@@ -85,6 +85,8 @@ bool Game::init(const std::string& title, int renderWidth, int renderHeight, int
     // Initialize game renderer
     m_gameRenderer.SetSDLRenderer(m_renderer);
     m_gameRenderer.SetCamera(&m_camera);
+    m_gameRenderer.SetBatching(true);
+    m_gameRenderer.SetSorting(true);
 
     // Register scenes
     auto* gameScene = m_sceneManager.RegisterScene<Scenes::GameScene>("game", &m_camera, &m_input);
@@ -284,6 +286,7 @@ void Game::update(float deltaTime) {
 }
 
 void Game::render() {
+    m_gameRenderer.ResetStats(); // Per-frame draw counters
     // === Render to internal resolution texture ===
     SDL_SetRenderTarget(m_renderer, m_renderTarget);
 
@@ -292,6 +295,7 @@ void Game::render() {
 
     // Draw current scene
     m_sceneManager.Draw();
+    m_gameRenderer.Flush();
 
     // === Render internal texture to screen ===
     SDL_SetRenderTarget(m_renderer, nullptr);
@@ -1,6 +1,8 @@
 #ifndef GRID_H
 #define GRID_H
 #include "engine/Entity.hpp"
+#include "engine/Rectangle.hpp"
+#include <vector>
 
 namespace Entities {
     class Grid : public Engine::Entity {
@@ -8,14 +10,23 @@ namespace Entities {
         int m_worldWidth = 0;
         int m_worldHeight = 0;
         int m_cellSize = 32;
+        std::vector<Engine::Rectangle<float>> m_cells; // Cell outlines, built once
 
     public:
         Grid(int worldWidth, int worldHeight, int cellSize = 32)
             : Entity(Engine::Vector2f(0.0f), {"grid", "background"}),
-              m_worldWidth(worldWidth), m_worldHeight(worldHeight), m_cellSize(cellSize) {}
+              m_worldWidth(worldWidth), m_worldHeight(worldHeight), m_cellSize(cellSize) {
+            Engine::Vector2f size(static_cast<float>(m_cellSize - 1), static_cast<float>(m_cellSize - 1));
+            for (int worldX = 0; worldX < m_worldWidth; worldX += m_cellSize) {
+                for (int worldY = 0; worldY < m_worldHeight; worldY += m_cellSize) {
+                    m_cells.emplace_back(Engine::Vector2f(static_cast<float>(worldX), static_cast<float>(worldY)), size);
+                }
+            }
+        }
 
         void Init() override {
             SetRenderLayer(0); // Background layer
+            Sleep();           // Static - drawn every frame, never updated
         }
 
         void Update(float deltaTime) override {
@@ -26,21 +37,18 @@ namespace Entities {
         void Draw() override {
             if (!m_renderer) return;
 
-            // Draw grid cells
+            // Draw grid cells (the renderer culls the ones off camera)
             m_renderer->SetColor(40, 40, 60);
-            for (int worldX = 0; worldX < m_worldWidth; worldX += m_cellSize) {
-                for (int worldY = 0; worldY < m_worldHeight; worldY += m_cellSize) {
-                    Engine::Vector2f pos(static_cast<float>(worldX), static_cast<float>(worldY));
-                    if (m_renderer->IsVisible(pos, m_cellSize, m_cellSize)) {
-                        m_renderer->DrawRect(pos, m_cellSize - 1, m_cellSize - 1);
-                    }
-                }
-            }
+            m_renderer->DrawRects(m_cells);
 
             // Draw corner markers
             m_renderer->SetColor(100, 100, 150);
-            m_renderer->DrawFilledRect(0.0f, 0.0f, 16, 16);
-            m_renderer->DrawFilledRect(static_cast<float>(m_worldWidth - 16), static_cast<float>(m_worldHeight - 16), 16, 16);
+            const Engine::Rectangle<float> corners[] = {
+                Engine::Rectangle<float>(Engine::Vector2f(0.0f, 0.0f), Engine::Vector2f(16.0f, 16.0f)),
+                Engine::Rectangle<float>(Engine::Vector2f(static_cast<float>(m_worldWidth - 16), static_cast<float>(m_worldHeight - 16)),
+                                         Engine::Vector2f(16.0f, 16.0f))
+            };
+            m_renderer->DrawFilledRects(corners, 2);
         }
     };
 }
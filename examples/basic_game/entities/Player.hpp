@@ -14,6 +14,7 @@ namespace Entities {
         float m_size = 16.0f;
         int m_worldWidth = 0;
         int m_worldHeight = 0;
+        Engine::TagId m_winTriggerTag = Engine::TagRegistry::Intern("win_trigger");
 
         Engine::Rectangle<float> m_bounds;
         Engine::CollisionRectangle<float> m_collider;
@@ -46,12 +47,13 @@ namespace Entities {
 
             SetPosition(newPos);
             m_bounds.SetPosition(newPos); // Sync collision bounds
+            if (m_collisionManager) m_collisionManager->UpdateCollider(this);
+        }
 
-            // Check for collision with win trigger
-            if (m_collisionManager && m_sceneManager) {
-                if (m_collisionManager->IsCollidingWithTag(this, "win_trigger")) {
-                    m_sceneManager->SwitchTo("win");
-                }
+        // Dispatched by the scene's CollisionManager::Step
+        void OnCollisionEnter(Engine::Entity* other) override {
+            if (m_sceneManager && other->HasTag(m_winTriggerTag)) {
+                m_sceneManager->SwitchTo("win");
             }
         }
 
@@ -23,12 +23,18 @@ namespace Entities {
 
         void Init() override {
             SetRenderLayer(5); // Middle layer
+            Sleep();           // Woken by CollisionManager::Step when something starts touching it
         }
 
         void Update(float deltaTime) override {
             (void)deltaTime;
             // Triggers don't move, but sync bounds position just in case
             m_bounds.SetPosition(GetPosition());
+
+            // Stay awake while touched - Step only wakes on a new contact
+            if (!m_collisionManager || m_collisionManager->GetContacts(this).empty()) {
+                Sleep();
+            }
         }
 
         void Draw() override {
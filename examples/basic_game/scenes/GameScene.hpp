@@ -54,6 +54,7 @@ namespace Scenes {
 
         void Update(float deltaTime) override {
             m_entityManager.UpdateAll(deltaTime);
+            m_collisionManager.Step(); // Contact callbacks (player reaching the win trigger)
 
             // Camera follows player with deadzone
             if (m_camera && m_player) {
@@ -87,15 +88,16 @@ namespace Scenes {
             );
 
             // Set dependencies on entities that need them (before Init)
-            m_player->SetCollisionManager(&m_collisionManager);
             m_player->SetSceneManager(m_sceneManager);
 
-            // Register collidables
+            // Register collidables - the trigger never moves, so it goes in the static tree,
+            // built here once rather than re-tested like a moving collider every frame
             m_collisionManager.Register(m_player);
-            m_collisionManager.Register(m_winTrigger);
+            m_collisionManager.RegisterStatic(m_winTrigger);
+            m_collisionManager.BakeStatic();
 
-            // Initialize all entities (sets renderer and entityManager automatically)
-            m_entityManager.InitAll(*m_renderer);
+            // Initialize all entities (sets renderer, entityManager and collision manager automatically)
+            m_entityManager.InitAll(*m_renderer, &m_collisionManager);
 
             // Center camera on player
             if (m_camera && m_player) {
@@ -18,6 +18,7 @@ private:
     Engine::CollisionRectangle<float> m_collider;
     int m_playerScore = 0;
     int m_aiScore = 0;
+    Engine::TagId m_paddleTag = Engine::TagRegistry::Intern("paddle");
 
 public:
     Ball(Engine::Vector2f position)
@@ -44,7 +45,16 @@ public:
         int worldHeight = m_gameMeta->GetWorldHeight();
 
         Engine::Vector2f pos = GetPosition();
-        pos = pos + m_velocity * deltaTime;
+        Engine::Vector2f displacement = m_velocity * deltaTime;
+        pos = pos + displacement;
+
+        // Sweep the whole step so a fast ball can't pass through a paddle between ticks
+        Engine::SweepHit hit;
+        bool hitPaddle = m_collisionManager && m_collisionManager->Sweep(this, displacement, hit) &&
+                         hit.entity->HasTag(m_paddleTag);
+        if (hitPaddle) {
+            pos = GetPosition() + displacement * hit.time;
+        }
 
         // Bounce off top/bottom walls
         if (pos.GetY() < 0) {
@@ -72,39 +82,38 @@ public:
             return;
         }
 
-        // Check paddle collisions
-        if (m_collisionManager) {
-            auto collisions = m_collisionManager->GetCollisionsWithTag(this, "paddle");
-            for (auto* paddle : collisions) {
-                // Bounce off paddle
-                m_velocity.SetX(-m_velocity.GetX());
-
-                // Add some angle based on where ball hit the paddle
-                float paddleCenter = paddle->GetPosition().GetY() + 24.0f; // half paddle height
-                float ballCenter = pos.GetY() + m_size / 2.0f;
-                float offset = (ballCenter - paddleCenter) / 24.0f; // -1 to 1
-                m_velocity.SetY(offset * m_speed);
-
-                // Push ball out of paddle
-                if (m_velocity.GetX() > 0) {
-                    pos.SetX(paddle->GetPosition().GetX() + 16.0f + 1.0f);
-                } else {
-                    pos.SetX(paddle->GetPosition().GetX() - m_size - 1.0f);
-                }
-
-                // Speed up slightly each hit
-                m_speed *= 1.05f;
-                float len = std::sqrt(m_velocity.GetX() * m_velocity.GetX() + m_velocity.GetY() * m_velocity.GetY());
-                m_velocity = m_velocity * (m_speed / len);
-
-                // Play paddle hit sound
-                if (m_audioManager) m_audioManager->Play("bing", 0);
-                break;
+        // Bounce off the paddle the sweep hit
+        if (hitPaddle) {
+            Engine::Entity* paddle = hit.entity;
+
+            // Bounce off paddle
+            m_velocity.SetX(-m_velocity.GetX());
+
+            // Add some angle based on where ball hit the paddle
+            float paddleCenter = paddle->GetPosition().GetY() + 24.0f; // half paddle height
+            float ballCenter = pos.GetY() + m_size / 2.0f;
+            float offset = (ballCenter - paddleCenter) / 24.0f; // -1 to 1
+            m_velocity.SetY(offset * m_speed);
+
+            // Push ball out of paddle
+            if (m_velocity.GetX() > 0) {
+                pos.SetX(paddle->GetPosition().GetX() + 16.0f + 1.0f);
+            } else {
+                pos.SetX(paddle->GetPosition().GetX() - m_size - 1.0f);
             }
+
+            // Speed up slightly each hit
+            m_speed *= 1.05f;
+            float len = std::sqrt(m_velocity.GetX() * m_velocity.GetX() + m_velocity.GetY() * m_velocity.GetY());
+            m_velocity = m_velocity * (m_speed / len);
+
+            // Play paddle hit sound
+            if (m_audioManager) m_audioManager->Play("bing", 0);
         }
 
         SetPosition(pos);
         m_bounds.SetPosition(pos);
+        if (m_collisionManager) m_collisionManager->UpdateCollider(this);
     }
 
     void Draw() override {
@@ -127,6 +136,7 @@ public:
             static_cast<float>(worldHeight) / 2.0f - m_size / 2.0f
         ));
         m_bounds.SetPosition(GetPosition());
+        if (m_collisionManager) m_collisionManager->UpdateCollider(this);
 
         // Reset speed and direction (alternate sides)
         m_speed = 150.0f;
@@ -17,6 +17,7 @@ private:
     Engine::Rectangle<float> m_bounds;
     Engine::CollisionRectangle<float> m_collider;
     bool m_bPlayerControlled = false;
+    Engine::TagId m_ballTag = Engine::TagRegistry::Intern("ball");
 
 public:
     Paddle(Engine::Vector2f position, Engine::Input* input, bool playerControlled = true)
@@ -52,7 +53,7 @@ public:
         } else {
             // AI: follow the ball
             if (m_entityManager) {
-                Engine::Entity* ball = m_entityManager->FindByTag("ball");
+                Engine::Entity* ball = m_entityManager->FindByTag(m_ballTag);
                 if (ball) {
                     float ballY = ball->GetPosition().GetY();
                     float paddleCenter = GetPosition().GetY() + m_paddleSize.GetY() / 2.0f;
@@ -77,6 +78,7 @@ public:
 
         SetPosition(newPos);
         m_bounds.SetPosition(newPos);
+        if (m_collisionManager) m_collisionManager->UpdateCollider(this);
     }
 
     void Draw() override {
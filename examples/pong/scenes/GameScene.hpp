@@ -34,7 +34,10 @@ namespace Scenes {
 
     public:
         GameScene(Engine::Camera* camera, Engine::Input* input)
-            : m_camera(camera), m_input(input) {}
+            : m_camera(camera), m_input(input) {
+            // Entities are rebuilt on every reset - keep them in the arena
+            m_entityManager.SetUseArena(true);
+        }
 
         void SetWorldSize(int width, int height) {
             m_gameMeta.SetWorldSize(width, height);
@@ -0,0 +1,246 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "engine/CollisionManager.hpp"
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Benchmarks are hidden by the [!benchmark] tag; run with: ./bin/smithy_tests "[!benchmark]"
+
+namespace {
+    class BenchCollider : public Engine::Entity, public Engine::ICollidable {
+    public:
+        Engine::Rectangle<float> bounds;
+        Engine::CollisionRectangle<float> collider;
+
+        BenchCollider(float x, float y, float size)
+            : Entity(Engine::Vector2f(x, y), {"enemy"}),
+              bounds(Engine::Vector2f(x, y), Engine::Vector2f(size, size)),
+              collider(&bounds) {}
+
+        Engine::CollisionRectangle<float>* GetCollider() override { return &collider; }
+        Engine::Entity* AsEntity() override { return this; }
+    };
+
+    // Shooter-like scene: small colliders spread over a large world
+    std::vector<std::unique_ptr<BenchCollider>> MakeScene(int count) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(0.0f, 4000.0f);
+        std::vector<std::unique_ptr<BenchCollider>> colliders;
+        for (int i = 0; i < count; i++) {
+            colliders.push_back(std::make_unique<BenchCollider>(position(rng), position(rng), 16.0f));
+        }
+        return colliders;
+    }
+
+    size_t QueryAll(Engine::CollisionManager& manager, std::vector<std::unique_ptr<BenchCollider>>& colliders) {
+        size_t hits = 0;
+        for (auto& collider : colliders) {
+            manager.ForEachCollision(collider.get(), [&hits](Engine::Entity*) { hits++; });
+        }
+        return hits;
+    }
+}
+
+TEST_CASE("CollisionManager every collider queries once", "[!benchmark][CollisionManager]") {
+    for (int count : {1000, 5000}) {
+        auto colliders = MakeScene(count);
+
+        Engine::CollisionManager bruteForce;
+        Engine::CollisionManager hashed;
+        hashed.SetBroadphase(Engine::Broadphase::SpatialHash);
+        hashed.SetCellSize(32.0f);
+        for (auto& collider : colliders) {
+            bruteForce.Register(collider.get());
+            hashed.Register(collider.get());
+        }
+
+        BENCHMARK("Brute force, " + std::to_string(count) + " colliders") {
+            return QueryAll(bruteForce, colliders);
+        };
+
+        BENCHMARK("Spatial hash, " + std::to_string(count) + " colliders") {
+            return QueryAll(hashed, colliders);
+        };
+    }
+}
+
+TEST_CASE("CollisionManager mixed collider sizes", "[!benchmark][CollisionManager]") {
+    // Mostly 8px balls plus a few huge trigger zones - the case a uniform grid handles badly
+    auto colliders = MakeScene(5000);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(0.0f, 3000.0f);
+    for (int i = 0; i < 50; i++) {
+        colliders.push_back(std::make_unique<BenchCollider>(position(rng), position(rng), 1000.0f));
+    }
+
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager hashed;
+    Engine::CollisionManager tree;
+    hashed.SetBroadphase(Engine::Broadphase::SpatialHash);
+    hashed.SetCellSize(16.0f);
+    tree.SetBroadphase(Engine::Broadphase::AABBTree);
+    for (auto& collider : colliders) {
+        bruteForce.Register(collider.get());
+        hashed.Register(collider.get());
+        tree.Register(collider.get());
+    }
+
+    BENCHMARK("Brute force, 5050 mixed colliders") {
+        return QueryAll(bruteForce, colliders);
+    };
+
+    BENCHMARK("Spatial hash, 5050 mixed colliders") {
+        return QueryAll(hashed, colliders);
+    };
+
+    BENCHMARK("AABB tree, 5050 mixed colliders") {
+        return QueryAll(tree, colliders);
+    };
+}
+
+TEST_CASE("CollisionManager steady state with small moves", "[!benchmark][CollisionManager]") {
+    // Every collider drifts a pixel per frame and is re-synced - frame coherence at work
+    auto colliders = MakeScene(5000);
+    Engine::CollisionManager hashed;
+    Engine::CollisionManager tree;
+    Engine::CollisionManager sweep;
+    hashed.SetBroadphase(Engine::Broadphase::SpatialHash);
+    hashed.SetCellSize(32.0f);
+    tree.SetBroadphase(Engine::Broadphase::AABBTree);
+    sweep.SetBroadphase(Engine::Broadphase::SweepAndPrune);
+    for (auto& collider : colliders) {
+        hashed.Register(collider.get());
+        tree.Register(collider.get());
+        sweep.Register(collider.get());
+    }
+
+    float step = 1.0f;
+    auto frame = [&colliders, &step](Engine::CollisionManager& manager) {
+        step = -step; // Back and forth so the scene doesn't wander off
+        for (auto& collider : colliders) {
+            Engine::Vector2f position = collider->bounds.GetPosition();
+            collider->bounds.SetPosition(Engine::Vector2f(position.GetX() + step, position.GetY()));
+        }
+        manager.Update();
+        return QueryAll(manager, colliders);
+    };
+
+    BENCHMARK("Spatial hash, 5000 drifting colliders") {
+        return frame(hashed);
+    };
+
+    BENCHMARK("AABB tree, 5000 drifting colliders") {
+        return frame(tree);
+    };
+
+    BENCHMARK("Sweep and prune, 5000 drifting colliders") {
+        return frame(sweep);
+    };
+}
+
+TEST_CASE("CollisionManager packed overlap kernel", "[!benchmark][CollisionManager]") {
+    // One box against 10000 - divide 10000 by the reported time for pair tests per second
+    auto colliders = MakeScene(10000);
+    Engine::PackedBounds packed;
+    for (size_t i = 0; i < colliders.size(); i++) {
+        packed.PushBack();
+        packed.Set(i, colliders[i]->bounds);
+    }
+    Engine::Rectangle<float> query(Engine::Vector2f(1000.0f, 1000.0f), Engine::Vector2f(200.0f, 200.0f));
+    Engine::CollisionRectangle<float> queryCollider(&query);
+
+    BENCHMARK("IsColliding through ICollidable, 10000 pair tests") {
+        size_t hits = 0;
+        for (auto& collider : colliders) {
+            Engine::ICollidable* other = collider.get();
+            if (queryCollider.IsColliding(*other->GetCollider())) hits++;
+        }
+        return hits;
+    };
+
+    BENCHMARK("PackedBounds kernel, 10000 pair tests") {
+        size_t hits = 0;
+        packed.ForEachOverlap(query, [&hits](size_t) { hits++; return true; });
+        return hits;
+    };
+
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager packedScan;
+    packedScan.SetBroadphase(Engine::Broadphase::PackedScan);
+    for (int i = 0; i < 5000; i++) {
+        bruteForce.Register(colliders[i].get());
+        packedScan.Register(colliders[i].get());
+    }
+    colliders.resize(5000);
+
+    BENCHMARK("Brute force, 5000 colliders query once") {
+        return QueryAll(bruteForce, colliders);
+    };
+
+    BENCHMARK("Packed scan, 5000 colliders query once") {
+        return QueryAll(packedScan, colliders);
+    };
+}
+
+TEST_CASE("CollisionManager dynamic colliders over static level geometry", "[!benchmark][CollisionManager]") {
+    // 1000 movers over 20000 wall tiles - the tiles only cost anything at bake time
+    auto movers = MakeScene(1000);
+    auto tiles = MakeScene(20000);
+
+    Engine::CollisionManager allDynamic;
+    Engine::CollisionManager withStatics;
+    allDynamic.SetBroadphase(Engine::Broadphase::AABBTree);
+    withStatics.SetBroadphase(Engine::Broadphase::AABBTree);
+    for (auto& tile : tiles) {
+        allDynamic.Register(tile.get());
+        withStatics.RegisterStatic(tile.get());
+    }
+    for (auto& mover : movers) {
+        allDynamic.Register(mover.get());
+        withStatics.Register(mover.get());
+    }
+
+    BENCHMARK("Bake 20000 statics") {
+        withStatics.BakeStatic();
+        return withStatics.StaticCount();
+    };
+
+    BENCHMARK("Step, 21000 dynamic colliders") {
+        allDynamic.Step();
+        return allDynamic.GetContactCount();
+    };
+
+    BENCHMARK("Step, 1000 dynamic + 20000 static colliders") {
+        withStatics.Step();
+        return withStatics.GetContactCount();
+    };
+}
+
+TEST_CASE("CollisionManager parallel Step scaling", "[!benchmark][CollisionManager]") {
+    // Crowd scene: 50000 colliders packed densely enough that most touch a few neighbours
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(0.0f, 6000.0f);
+    std::vector<std::unique_ptr<BenchCollider>> colliders;
+    for (int i = 0; i < 50000; i++) {
+        colliders.push_back(std::make_unique<BenchCollider>(position(rng), position(rng), 24.0f));
+    }
+
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        Engine::ThreadPool pool(threads);
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(Engine::Broadphase::SpatialHash);
+        manager.SetCellSize(32.0f);
+        manager.SetThreadPool(&pool);
+        for (auto& collider : colliders) {
+            manager.Register(collider.get());
+        }
+
+        BENCHMARK("Step, 50000 colliders, " + std::to_string(threads) + " threads") {
+            manager.Step();
+            return manager.GetContactCount();
+        };
+    }
+}
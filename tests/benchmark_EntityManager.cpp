@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "engine/EntityManager.hpp"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Benchmarks are hidden by the [!benchmark] tag; run with: ./bin/smithy_tests "[!benchmark]"
+
+namespace {
+    class BenchEntity : public Engine::Entity {
+    public:
+        BenchEntity(std::initializer_list<std::string> tags) : Entity(Engine::Vector2f(0.0f), tags) {}
+    };
+
+    void Populate(Engine::EntityManager& manager, int count) {
+        for (int i = 0; i < count; i++) {
+            manager.Create<BenchEntity>(std::initializer_list<std::string>{"bullet", "projectile"});
+            manager.Create<BenchEntity>(std::initializer_list<std::string>{"enemy", "projectile"});
+        }
+    }
+}
+
+TEST_CASE("EntityManager mass removal", "[!benchmark][EntityManager]") {
+    // Cost per removed entity should stay flat as the count grows
+    for (int count : {1000, 10000}) {
+        BENCHMARK_ADVANCED("RemoveByTag + compaction, " + std::to_string(count) + " bullets")(Catch::Benchmark::Chronometer meter) {
+            std::vector<Engine::EntityManager> managers(meter.runs());
+            for (auto& manager : managers) {
+                Populate(manager, count);
+            }
+            meter.measure([&](int i) {
+                managers[i].RemoveByTag("bullet");
+                managers[i].UpdateAll(0.0f);
+                return managers[i].Count();
+            });
+        };
+    }
+}
+
+namespace {
+    class Mover : public Engine::Entity {
+    public:
+        float velocity = 1.0f;
+    };
+}
+
+TEST_CASE("EntityManager iteration", "[!benchmark][EntityManager]") {
+    Engine::EntityManager manager;
+    for (int i = 0; i < 10000; i++) {
+        manager.Create<Mover>();
+    }
+
+    BENCHMARK("ForEach via std::function") {
+        float sum = 0.0f;
+        std::function<void(Engine::Entity*)> callback = [&](Engine::Entity* entity) {
+            sum += entity->GetPosition().GetX();
+        };
+        manager.ForEach(callback);
+        return sum;
+    };
+
+    BENCHMARK("ForEach via lambda") {
+        float sum = 0.0f;
+        manager.ForEach([&](Engine::Entity* entity) {
+            sum += entity->GetPosition().GetX();
+        });
+        return sum;
+    };
+
+    BENCHMARK("ForEach + dynamic_cast") {
+        float sum = 0.0f;
+        manager.ForEach([&](Engine::Entity* entity) {
+            if (auto* mover = dynamic_cast<Mover*>(entity)) sum += mover->velocity;
+        });
+        return sum;
+    };
+
+    BENCHMARK("ForEachOfType") {
+        float sum = 0.0f;
+        manager.ForEachOfType<Mover>([&](Mover* mover) {
+            sum += mover->velocity;
+        });
+        return sum;
+    };
+}
+
+namespace {
+    // Enough per-entity work for threading to pay off
+    class BusyEntity : public Engine::Entity {
+    public:
+        float value = 1.0f;
+        BusyEntity() { SetThreadSafe(true); }
+        void Update(float deltaTime) override {
+            for (int i = 0; i < 200; i++) {
+                value = value * 0.999f + deltaTime;
+            }
+        }
+    };
+}
+
+TEST_CASE("EntityManager parallel update scaling", "[!benchmark][EntityManager]") {
+    // Powers of two, always ending on the full hardware thread count (e.g. 1, 2, 4, 6)
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (size_t threads : threadCounts) {
+        Engine::ThreadPool pool(threads);
+        Engine::EntityManager manager;
+        manager.SetThreadPool(&pool);
+        for (int i = 0; i < 20000; i++) {
+            manager.Create<BusyEntity>();
+        }
+
+        BENCHMARK("UpdateAll 20k entities, " + std::to_string(threads) + " threads") {
+            manager.UpdateAll(0.016f);
+            return manager.Count();
+        };
+    }
+}
+
+TEST_CASE("EntityManager draw with constant spawning", "[!benchmark][EntityManager]") {
+    // Spawning used to force a full re-sort on the next draw - now it is a bucket append
+    Engine::EntityManager manager;
+    for (int i = 0; i < 10000; i++) {
+        manager.Create<Mover>()->SetRenderLayer(i % 8);
+    }
+
+    BENCHMARK("Spawn 10 + DrawAll, 10k entities over 8 layers") {
+        for (int i = 0; i < 10; i++) {
+            manager.Create<Mover>()->SetRenderLayer(i % 8);
+        }
+        manager.DrawAll();
+        return manager.Count();
+    };
+}
@@ -0,0 +1,794 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/CollisionManager.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    class Box : public Engine::Entity, public Engine::ICollidable {
+    public:
+        Engine::Rectangle<float> bounds;
+        Engine::CollisionRectangle<float> collider;
+
+        Box(float x, float y, float w, float h, std::initializer_list<std::string> tags = {})
+            : Entity(Engine::Vector2f(x, y), tags),
+              bounds(Engine::Vector2f(x, y), Engine::Vector2f(w, h)),
+              collider(&bounds) {}
+
+        void MoveTo(float x, float y) {
+            SetPosition(Engine::Vector2f(x, y));
+            bounds.SetPosition(Engine::Vector2f(x, y));
+        }
+
+        Engine::CollisionRectangle<float>* GetCollider() override { return &collider; }
+        Engine::Entity* AsEntity() override { return this; }
+    };
+
+    // Records contact callbacks as "enter:<tag>" etc. using the other entity's first tag
+    class ContactBox : public Box {
+    public:
+        std::vector<std::string> log;
+
+        using Box::Box;
+
+        void OnCollisionEnter(Engine::Entity* other) override { log.push_back("enter:" + *other->GetTags().begin()); }
+        void OnCollisionStay(Engine::Entity* other) override { log.push_back("stay:" + *other->GetTags().begin()); }
+        void OnCollisionExit(Engine::Entity* other) override { log.push_back("exit:" + *other->GetTags().begin()); }
+    };
+
+    std::vector<std::unique_ptr<Box>> MakeBoxes(int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+        std::uniform_real_distribution<float> size(1.0f, 40.0f);
+        std::vector<std::unique_ptr<Box>> boxes;
+        for (int i = 0; i < count; i++) {
+            boxes.push_back(std::make_unique<Box>(position(rng), position(rng), size(rng), size(rng),
+                i % 3 == 0 ? std::initializer_list<std::string>{"enemy"} : std::initializer_list<std::string>{}));
+        }
+        return boxes;
+    }
+}
+
+TEST_CASE("CollisionManager spatial hash matches brute force", "[CollisionManager]") {
+    auto boxes = MakeBoxes(500, 7);
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager hashed;
+    hashed.SetBroadphase(Engine::Broadphase::SpatialHash);
+    hashed.SetCellSize(32.0f);
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+        hashed.Register(box.get());
+    }
+
+    // Move some colliders and re-bucket them incrementally
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    for (size_t i = 0; i < boxes.size(); i += 4) {
+        boxes[i]->MoveTo(position(rng), position(rng));
+        hashed.UpdateCollider(boxes[i].get());
+    }
+    // Unregistering and re-registering reuses ids but keeps registration order
+    hashed.Unregister(boxes[10].get());
+    bruteForce.Unregister(boxes[10].get());
+    hashed.Register(boxes[10].get());
+    bruteForce.Register(boxes[10].get());
+
+    size_t hits = 0;
+    for (auto& box : boxes) {
+        auto expected = bruteForce.GetCollisions(box.get());
+        REQUIRE(hashed.GetCollisions(box.get()) == expected);
+        REQUIRE(hashed.GetCollisionsWithTag(box.get(), "enemy") == bruteForce.GetCollisionsWithTag(box.get(), "enemy"));
+        REQUIRE(hashed.IsCollidingWithTag(box.get(), "enemy") == bruteForce.IsCollidingWithTag(box.get(), "enemy"));
+        hits += expected.size();
+    }
+    REQUIRE(hits > 0);
+}
+
+TEST_CASE("CollisionManager spatial hash sees moved colliders after update", "[CollisionManager]") {
+    Box a(0.0f, 0.0f, 10.0f, 10.0f);
+    Box b(500.0f, 500.0f, 10.0f, 10.0f);
+    Engine::CollisionManager manager;
+    manager.SetBroadphase(Engine::Broadphase::SpatialHash);
+    manager.Register(&a);
+    manager.Register(&b);
+    REQUIRE(manager.GetCollisions(&a).empty());
+
+    b.MoveTo(5.0f, 5.0f);
+    manager.Update();
+    REQUIRE(manager.GetCollisions(&a) == std::vector<Engine::Entity*>{&b});
+
+    // Switching back keeps answering the same way
+    manager.SetBroadphase(Engine::Broadphase::BruteForce);
+    REQUIRE(manager.GetCollisions(&a) == std::vector<Engine::Entity*>{&b});
+}
+
+TEST_CASE("CollisionManager spatial hash handles huge and far-off colliders", "[CollisionManager]") {
+    auto boxes = MakeBoxes(100, 5);
+    boxes.push_back(std::make_unique<Box>(-1e30f, -1e30f, 2e30f, 2e30f)); // Covers everything
+    boxes.push_back(std::make_unique<Box>(1e9f, 1e9f, 1000.0f, 1000.0f)); // Far past the cell range
+    boxes.push_back(std::make_unique<Box>(1e9f, 1e9f, 512.0f, 512.0f));
+    boxes.push_back(std::make_unique<Box>(-5000.0f, 0.0f, 10000.0f, 8.0f)); // Wide, but still bucketed
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager hashed;
+    hashed.SetBroadphase(Engine::Broadphase::SpatialHash);
+    hashed.SetCellSize(1.0f);
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+        hashed.Register(box.get());
+    }
+
+    for (auto& box : boxes) {
+        REQUIRE(hashed.GetCollisions(box.get()) == bruteForce.GetCollisions(box.get()));
+    }
+    REQUIRE(hashed.GetCollisions(boxes[101].get()).size() == 2); // The huge box and its neighbour
+
+    // A query wider than the grid scans the buckets instead of walking cells
+    std::vector<Engine::Entity*> found;
+    std::vector<Engine::Entity*> expected;
+    Engine::Rectangle<float> everywhere(Engine::Vector2f(-1e25f, -1e25f), Engine::Vector2f(2e25f, 2e25f));
+    REQUIRE(hashed.QueryRect(everywhere, found) == boxes.size());
+    bruteForce.QueryRect(everywhere, expected);
+    REQUIRE(found == expected);
+
+    // Oversized colliders can shrink back into buckets and leave again
+    boxes[100]->MoveTo(0.0f, 0.0f);
+    boxes[100]->bounds.SetSize(Engine::Vector2f(4.0f, 4.0f));
+    hashed.UpdateCollider(boxes[100].get());
+    bruteForce.UpdateCollider(boxes[100].get());
+    hashed.Unregister(boxes[103].get());
+    bruteForce.Unregister(boxes[103].get());
+    for (auto& box : boxes) {
+        REQUIRE(hashed.GetCollisions(box.get()) == bruteForce.GetCollisions(box.get()));
+    }
+}
+
+TEST_CASE("CollisionManager AABB tree matches brute force with mixed sizes", "[CollisionManager]") {
+    auto boxes = MakeBoxes(400, 3);
+    boxes.push_back(std::make_unique<Box>(100.0f, 100.0f, 600.0f, 500.0f)); // Huge trigger zone
+    boxes.push_back(std::make_unique<Box>(0.0f, 0.0f, 2.0f, 2.0f));
+
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager tree;
+    tree.SetBroadphase(Engine::Broadphase::AABBTree);
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+        tree.Register(box.get());
+    }
+
+    // Small moves stay inside the fat boxes, large ones force re-inserts
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    for (size_t i = 0; i < boxes.size(); i += 3) {
+        Engine::Vector2f current = boxes[i]->GetPosition();
+        if (i % 2 == 0) {
+            boxes[i]->MoveTo(current.GetX() + 1.0f, current.GetY() - 1.0f);
+        } else {
+            boxes[i]->MoveTo(position(rng), position(rng));
+        }
+        tree.UpdateCollider(boxes[i].get());
+    }
+    for (size_t i = 1; i < boxes.size(); i += 7) {
+        tree.Unregister(boxes[i].get());
+        bruteForce.Unregister(boxes[i].get());
+    }
+
+    for (auto& box : boxes) {
+        REQUIRE(tree.GetCollisions(box.get()) == bruteForce.GetCollisions(box.get()));
+    }
+}
+
+TEST_CASE("AABBTree stays balanced", "[CollisionManager]") {
+    Engine::AABBTree tree(0.0f);
+    // Inserting along a line is the worst case for an unbalanced tree
+    for (uint32_t i = 0; i < 1024; i++) {
+        float x = static_cast<float>(i) * 10.0f;
+        tree.Insert(Engine::AABB(x, 0.0f, x + 5.0f, 5.0f), i);
+    }
+    REQUIRE(tree.Count() == 1024);
+    REQUIRE(tree.GetHeight() <= 20);
+
+    std::vector<uint32_t> found;
+    tree.Query(Engine::AABB(100.0f, 1.0f, 112.0f, 2.0f), [&found](uint32_t id) { found.push_back(id); });
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == std::vector<uint32_t>{10, 11});
+}
+
+TEST_CASE("CollisionManager sweep and prune matches brute force across frames", "[CollisionManager]") {
+    auto boxes = MakeBoxes(400, 13);
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager sweep;
+    sweep.SetBroadphase(Engine::Broadphase::SweepAndPrune);
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+        sweep.Register(box.get());
+    }
+
+    // Mostly small jitter with the odd teleport, as in a real frame loop
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> jitter(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    for (int frame = 0; frame < 10; frame++) {
+        for (size_t i = 0; i < boxes.size(); i++) {
+            Engine::Vector2f current = boxes[i]->GetPosition();
+            if (i % 50 == static_cast<size_t>(frame)) {
+                boxes[i]->MoveTo(position(rng), position(rng));
+            } else {
+                boxes[i]->MoveTo(current.GetX() + jitter(rng), current.GetY() + jitter(rng));
+            }
+        }
+        sweep.Update();
+        if (frame == 4) {
+            sweep.Unregister(boxes[20].get());
+            bruteForce.Unregister(boxes[20].get());
+        }
+        for (auto& box : boxes) {
+            REQUIRE(sweep.GetCollisions(box.get()) == bruteForce.GetCollisions(box.get()));
+        }
+    }
+}
+
+TEST_CASE("CollisionManager sweep and prune reports pairs as they cross", "[CollisionManager]") {
+    Box a(0.0f, 0.0f, 10.0f, 10.0f);
+    Box b(100.0f, 0.0f, 10.0f, 10.0f);
+    Box c(100.0f, 200.0f, 10.0f, 10.0f);
+    Engine::CollisionManager manager;
+    manager.SetBroadphase(Engine::Broadphase::SweepAndPrune);
+    manager.SetOverlapEventsEnabled(true);
+    manager.Register(&a);
+    manager.Register(&b);
+    manager.Register(&c);
+    REQUIRE(manager.GetOverlapEvents().empty());
+
+    // Overlapping on X alone (c is far below) is not a pair
+    a.MoveTo(95.0f, 0.0f);
+    manager.UpdateCollider(&a);
+    REQUIRE(manager.GetOverlapPairCount() == 1);
+    REQUIRE(manager.GetOverlapEvents().size() == 1);
+    REQUIRE(manager.GetOverlapEvents()[0].a == &a);
+    REQUIRE(manager.GetOverlapEvents()[0].b == &b);
+    REQUIRE(manager.GetOverlapEvents()[0].began);
+    manager.ClearOverlapEvents();
+
+    // Jumping clean over b ends the pair without a stray begin
+    a.MoveTo(300.0f, 0.0f);
+    manager.UpdateCollider(&a);
+    REQUIRE(manager.GetOverlapPairCount() == 0);
+    REQUIRE(manager.GetOverlapEvents().size() == 1);
+    REQUIRE_FALSE(manager.GetOverlapEvents()[0].began);
+    manager.ClearOverlapEvents();
+
+    // Unregistering ends its pairs
+    c.MoveTo(100.0f, 5.0f);
+    manager.UpdateCollider(&c);
+    manager.Unregister(&b);
+    REQUIRE(manager.GetOverlapPairCount() == 0);
+    REQUIRE(manager.GetOverlapEvents().size() == 2);
+    REQUIRE(manager.GetOverlapEvents()[1].a == &b);
+    REQUIRE(manager.GetOverlapEvents()[1].b == &c);
+    REQUIRE_FALSE(manager.GetOverlapEvents()[1].began);
+}
+
+TEST_CASE("CollisionManager Step caches contacts and dispatches enter/stay/exit", "[CollisionManager]") {
+    ContactBox player(0.0f, 0.0f, 10.0f, 10.0f, {"player"});
+    ContactBox trigger(50.0f, 0.0f, 10.0f, 10.0f, {"trigger"});
+    ContactBox wall(100.0f, 0.0f, 10.0f, 10.0f, {"wall"});
+    Engine::CollisionManager manager;
+    manager.SetBroadphase(Engine::Broadphase::SpatialHash);
+    manager.Register(&player);
+    manager.Register(&trigger);
+    manager.Register(&wall);
+    Engine::TagId triggerTag = Engine::TagRegistry::Intern("trigger");
+
+    manager.Step();
+    REQUIRE(manager.GetContactCount() == 0);
+    REQUIRE(player.log.empty());
+
+    player.MoveTo(45.0f, 0.0f);
+    manager.UpdateCollider(&player);
+    manager.Step();
+    REQUIRE(player.log == std::vector<std::string>{"enter:trigger"});
+    REQUIRE(trigger.log == std::vector<std::string>{"enter:player"});
+    REQUIRE(manager.GetContacts(&player) == std::vector<Engine::Entity*>{&trigger});
+    REQUIRE(manager.HasContactWithTag(&player, triggerTag));
+
+    manager.Step();
+    REQUIRE(player.log.back() == "stay:trigger");
+
+    // Leaving one pair and entering another in the same frame
+    player.MoveTo(95.0f, 0.0f);
+    manager.UpdateCollider(&player);
+    manager.Step();
+    REQUIRE(player.log == std::vector<std::string>{"enter:trigger", "stay:trigger", "exit:trigger", "enter:wall"});
+    REQUIRE(trigger.log.back() == "exit:player");
+    REQUIRE_FALSE(manager.HasContactWithTag(&player, triggerTag));
+    REQUIRE(manager.GetContacts(&wall) == std::vector<Engine::Entity*>{&player});
+
+    // Unregistering ends the pair for the partner straight away
+    manager.Unregister(&player);
+    REQUIRE(wall.log.back() == "exit:player");
+    REQUIRE(manager.GetContacts(&wall).empty());
+    manager.Step();
+    REQUIRE(wall.log.size() == 2);
+}
+
+TEST_CASE("CollisionManager Step finds the same pairs with every broadphase", "[CollisionManager]") {
+    auto boxes = MakeBoxes(300, 21);
+    Engine::CollisionManager bruteForce;
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+    }
+    bruteForce.Step();
+    REQUIRE(bruteForce.GetContactCount() > 0);
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::SpatialHash, Engine::Broadphase::AABBTree,
+                                          Engine::Broadphase::SweepAndPrune, Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        for (auto& box : boxes) {
+            manager.Register(box.get());
+        }
+        manager.Step();
+        REQUIRE(manager.GetContactCount() == bruteForce.GetContactCount());
+        for (auto& box : boxes) {
+            REQUIRE(manager.GetContacts(box.get()) == bruteForce.GetContacts(box.get()));
+            REQUIRE(manager.GetContacts(box.get()) == bruteForce.GetCollisions(box.get()));
+        }
+    }
+}
+
+TEST_CASE("PackedBounds agrees with CollisionRectangle::IsColliding", "[CollisionManager]") {
+    // Whole-pixel coordinates so plenty of boxes share edges; some sizes are negative
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> position(0, 60);
+    std::uniform_int_distribution<int> size(-4, 12);
+    std::vector<Engine::Rectangle<float>> rectangles;
+    for (int i = 0; i < 203; i++) { // Not a multiple of 8, so the scalar tail runs too
+        rectangles.emplace_back(Engine::Vector2f(static_cast<float>(position(rng)), static_cast<float>(position(rng))),
+                                Engine::Vector2f(static_cast<float>(size(rng)), static_cast<float>(size(rng))));
+    }
+
+    Engine::PackedBounds packed;
+    for (size_t i = 0; i < rectangles.size(); i++) {
+        packed.PushBack();
+        packed.Set(i, rectangles[i]);
+    }
+    packed.SetEmpty(5);
+
+    size_t hits = 0;
+    for (auto& query : rectangles) {
+        Engine::CollisionRectangle<float> queryCollider(&query);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < rectangles.size(); i++) {
+            Engine::CollisionRectangle<float> other(&rectangles[i]);
+            if (i != 5 && queryCollider.IsColliding(other)) expected.push_back(i);
+        }
+        std::vector<size_t> found;
+        packed.ForEachOverlap(query, [&found](size_t index) { found.push_back(index); return true; });
+        REQUIRE(found == expected);
+        hits += found.size();
+    }
+    REQUIRE(hits > rectangles.size());
+}
+
+TEST_CASE("CollisionManager packed scan matches brute force", "[CollisionManager]") {
+    auto boxes = MakeBoxes(300, 29);
+    Engine::CollisionManager bruteForce;
+    Engine::CollisionManager packed;
+    packed.SetBroadphase(Engine::Broadphase::PackedScan);
+    for (auto& box : boxes) {
+        bruteForce.Register(box.get());
+        packed.Register(box.get());
+    }
+
+    for (size_t i = 0; i < boxes.size(); i += 5) {
+        boxes[i]->MoveTo(boxes[i]->GetPosition().GetX() + 7.0f, boxes[i]->GetPosition().GetY());
+        packed.UpdateCollider(boxes[i].get());
+    }
+    // Unregistering from the middle shifts the packed slots down
+    for (size_t i = 3; i < boxes.size(); i += 11) {
+        packed.Unregister(boxes[i].get());
+        bruteForce.Unregister(boxes[i].get());
+    }
+
+    for (auto& box : boxes) {
+        REQUIRE(packed.GetCollisions(box.get()) == bruteForce.GetCollisions(box.get()));
+        REQUIRE(packed.IsCollidingWithTag(box.get(), "enemy") == bruteForce.IsCollidingWithTag(box.get(), "enemy"));
+    }
+}
+
+TEST_CASE("CollisionManager layers filter queries with every broadphase", "[CollisionManager]") {
+    auto boxes = MakeBoxes(400, 31);
+    const Engine::CollisionLayer layerOf[] = {0, 1, 2, 5};
+    auto layerFor = [&](size_t i) { return layerOf[i % 4]; };
+
+    // Expected results come from an unlayered manager filtered by hand
+    Engine::CollisionManager reference;
+    for (auto& box : boxes) {
+        reference.Register(box.get());
+    }
+    auto expected = [&](size_t self, Engine::CollisionLayerMask layers) {
+        std::vector<Engine::Entity*> results;
+        for (Engine::Entity* other : reference.GetCollisions(boxes[self].get())) {
+            for (size_t i = 0; i < boxes.size(); i++) {
+                if (boxes[i].get() == other && (Engine::CollisionManager::LayerBit(layerFor(i)) & layers)) {
+                    results.push_back(other);
+                }
+            }
+        }
+        return results;
+    };
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::SpatialHash,
+                                          Engine::Broadphase::AABBTree, Engine::Broadphase::SweepAndPrune,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        manager.SetLayersInteract(1, 2, false);
+        manager.SetLayersInteract(5, 5, false);
+        for (size_t i = 0; i < boxes.size(); i++) {
+            manager.Register(boxes[i].get(), layerFor(i));
+        }
+        REQUIRE(manager.CountInLayer(1) == 100);
+        REQUIRE_FALSE(manager.DoLayersInteract(2, 1));
+
+        const Engine::CollisionLayerMask layers12 = Engine::CollisionManager::LayerBit(1) | Engine::CollisionManager::LayerBit(2);
+        for (size_t i = 0; i < boxes.size(); i++) {
+            Engine::CollisionLayerMask sees = manager.GetLayerMask(layerFor(i));
+            REQUIRE(manager.GetCollisions(boxes[i].get()) == expected(i, sees));
+            REQUIRE(manager.GetCollisionsInLayers(boxes[i].get(), layers12) == expected(i, sees & layers12));
+            REQUIRE(manager.IsCollidingWithLayers(boxes[i].get(), Engine::CollisionManager::LayerBit(0)) ==
+                    !expected(i, Engine::CollisionManager::LayerBit(0)).empty());
+        }
+
+        // Step respects the matrix from both sides
+        manager.Step();
+        for (size_t i = 0; i < boxes.size(); i++) {
+            REQUIRE(manager.GetContacts(boxes[i].get()) == expected(i, manager.GetLayerMask(layerFor(i))));
+        }
+    }
+}
+
+TEST_CASE("CollisionManager SetLayer moves a collider between layer lists", "[CollisionManager]") {
+    Box a(0, 0, 10, 10, {"a"});
+    Box b(5, 5, 10, 10, {"b"});
+    Box c(5, 0, 10, 10, {"c"});
+    Engine::CollisionManager manager;
+    manager.Register(&a);
+    manager.Register(&b, 3);
+    manager.Register(&c, 3);
+    manager.SetLayersInteract(0, 3, false);
+    REQUIRE(manager.GetCollisions(&a).empty());
+
+    manager.SetLayer(&b, 0);
+    REQUIRE(manager.GetLayer(&b) == 0);
+    REQUIRE(manager.CountInLayer(3) == 1);
+    REQUIRE(manager.GetCollisions(&a) == std::vector<Engine::Entity*>{&b});
+
+    // Moving back keeps registration order in the merged walk
+    manager.SetLayersInteract(0, 3, true);
+    manager.SetLayer(&b, 3);
+    REQUIRE(manager.GetCollisionsInLayers(&a, Engine::CollisionManager::LayerBit(3)) == std::vector<Engine::Entity*>{&b, &c});
+
+    manager.Unregister(&b);
+    manager.Unregister(&c);
+    REQUIRE(manager.CountInLayer(3) == 0);
+    REQUIRE(manager.GetCollisionsInLayers(&a, Engine::CollisionManager::AllLayers).empty());
+}
+
+TEST_CASE("AABB sweep finds time of impact and normal", "[CollisionManager]") {
+    Engine::AABB mover(0, 0, 10, 10);
+    Engine::AABB wall(50, -20, 52, 40); // Thin - a discrete step of 100 jumps right over it
+    float time, normalX, normalY;
+
+    REQUIRE(mover.Sweep(wall, 100.0f, 0.0f, time, normalX, normalY));
+    REQUIRE(time == 0.4f);
+    REQUIRE(normalX == -1.0f);
+    REQUIRE(normalY == 0.0f);
+
+    // Moving away, stopping short, or sliding flush along a face never hits
+    REQUIRE_FALSE(mover.Sweep(wall, -100.0f, 0.0f, time, normalX, normalY));
+    REQUIRE_FALSE(mover.Sweep(wall, 30.0f, 0.0f, time, normalX, normalY));
+    REQUIRE_FALSE(Engine::AABB(0, 40, 10, 50).Sweep(wall, 100.0f, 0.0f, time, normalX, normalY));
+
+    // Diagonal into the top face
+    Engine::AABB floor(0, 100, 200, 110);
+    REQUIRE(mover.Sweep(floor, 50.0f, 180.0f, time, normalX, normalY));
+    REQUIRE(time == 0.5f);
+    REQUIRE(normalY == -1.0f);
+
+    // Already overlapping
+    REQUIRE(mover.Sweep(Engine::AABB(5, 5, 20, 20), 1.0f, 1.0f, time, normalX, normalY));
+    REQUIRE(time == 0.0f);
+    REQUIRE(normalX == 0.0f);
+    REQUIRE(normalY == 0.0f);
+}
+
+TEST_CASE("CollisionManager Sweep catches thin colliders with every broadphase", "[CollisionManager]") {
+    Box bullet(0, 0, 4, 4, {"bullet"});
+    Box nearWall(100, -50, 2, 100, {"near"});
+    Box farWall(200, -50, 2, 100, {"far"});
+    Box ceiling(0, -30, 500, 2, {"ceiling"});
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::SpatialHash,
+                                          Engine::Broadphase::AABBTree, Engine::Broadphase::SweepAndPrune,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        manager.SetCellSize(16.0f);
+        manager.Register(&bullet);
+        manager.Register(&farWall);
+        manager.Register(&nearWall, 1);
+        manager.Register(&ceiling);
+
+        // The discrete test at the end of the step misses both walls
+        bullet.MoveTo(300, 0);
+        REQUIRE(manager.GetCollisions(&bullet).empty());
+        bullet.MoveTo(0, 0);
+
+        Engine::SweepHit hit;
+        REQUIRE(manager.Sweep(&bullet, Engine::Vector2f(300.0f, 0.0f), hit));
+        REQUIRE(hit.entity == &nearWall);
+        REQUIRE(hit.time == 96.0f / 300.0f);
+        REQUIRE(hit.normal.GetX() == -1.0f);
+
+        // Layer filtering skips the near wall
+        REQUIRE(manager.Sweep(&bullet, Engine::Vector2f(300.0f, 0.0f), hit, Engine::CollisionManager::LayerBit(0)));
+        REQUIRE(hit.entity == &farWall);
+
+        REQUIRE(manager.Sweep(&bullet, Engine::Vector2f(0.0f, -100.0f), hit));
+        REQUIRE(hit.entity == &ceiling);
+        REQUIRE(hit.normal.GetY() == 1.0f);
+
+        REQUIRE_FALSE(manager.Sweep(&bullet, Engine::Vector2f(50.0f, 0.0f), hit));
+        REQUIRE(hit.entity == nullptr);
+    }
+}
+
+TEST_CASE("StaticBVH finds the same boxes as a linear scan", "[CollisionManager]") {
+    auto boxes = MakeBoxes(1000, 37);
+    std::vector<Engine::StaticBVH::Entry> entries;
+    for (uint32_t i = 0; i < boxes.size(); i++) {
+        entries.push_back({Engine::AABB::FromRectangle(boxes[i]->bounds), i});
+    }
+    Engine::StaticBVH tree;
+    tree.Build(entries);
+    REQUIRE(tree.Count() == boxes.size());
+
+    for (auto& query : MakeBoxes(200, 41)) {
+        Engine::AABB bounds = Engine::AABB::FromRectangle(query->bounds);
+        std::vector<uint32_t> expected;
+        for (const auto& entry : entries) {
+            if (entry.bounds.Overlaps(bounds)) expected.push_back(entry.userData);
+        }
+        std::vector<uint32_t> found;
+        tree.Query(bounds, [&found](uint32_t id) { found.push_back(id); });
+        std::sort(found.begin(), found.end());
+        REQUIRE(found == expected);
+    }
+}
+
+TEST_CASE("CollisionManager statics are only tested against dynamic colliders", "[CollisionManager]") {
+    auto dynamics = MakeBoxes(300, 43);
+    auto statics = MakeBoxes(200, 47);
+    auto isStaticBox = [&](Engine::Entity* entity) {
+        for (auto& box : statics) {
+            if (box.get() == entity) return true;
+        }
+        return false;
+    };
+
+    // Everything dynamic, statics registered last so they order last like real statics
+    Engine::CollisionManager reference;
+    for (auto& box : dynamics) reference.Register(box.get());
+    for (auto& box : statics) reference.Register(box.get());
+    reference.Step();
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::SpatialHash,
+                                          Engine::Broadphase::AABBTree, Engine::Broadphase::SweepAndPrune,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        // Statics first, to show their order doesn't depend on registration time
+        for (auto& box : statics) manager.RegisterStatic(box.get());
+        manager.BakeStatic();
+        for (auto& box : dynamics) manager.Register(box.get());
+        REQUIRE(manager.Count() == dynamics.size());
+        REQUIRE(manager.StaticCount() == statics.size());
+        REQUIRE(manager.IsStatic(statics[0].get()));
+
+        manager.Step();
+        for (auto& box : dynamics) {
+            REQUIRE(manager.GetCollisions(box.get()) == reference.GetCollisions(box.get()));
+            REQUIRE(manager.GetContacts(box.get()) == reference.GetContacts(box.get()));
+        }
+        for (auto& box : statics) {
+            std::vector<Engine::Entity*> expected = reference.GetContacts(box.get());
+            expected.erase(std::remove_if(expected.begin(), expected.end(), isStaticBox), expected.end());
+            REQUIRE(manager.GetContacts(box.get()) == expected);
+        }
+    }
+}
+
+TEST_CASE("CollisionManager statics can change between bakes", "[CollisionManager]") {
+    Box mover(0, 0, 10, 10, {"mover"});
+    Box wallA(5, 0, 10, 10, {"a"});
+    Box wallB(5, 5, 10, 10, {"b"});
+    Box wallC(0, 5, 10, 10, {"c"});
+    Engine::CollisionManager manager;
+    manager.SetBroadphase(Engine::Broadphase::AABBTree);
+    manager.Register(&mover);
+    manager.RegisterStatic(&wallA);
+    manager.BakeStatic();
+
+    // Registered after the bake: scanned until the next one
+    manager.RegisterStatic(&wallB);
+    REQUIRE(manager.GetCollisions(&mover) == std::vector<Engine::Entity*>{&wallA, &wallB});
+
+    // A baked static unregistered before the rebake drops out straight away, and its
+    // proxy id isn't handed to a new collider while the tree still refers to it
+    manager.Unregister(&wallA);
+    manager.Register(&wallC);
+    REQUIRE(manager.GetCollisions(&mover) == std::vector<Engine::Entity*>{&wallC, &wallB});
+    REQUIRE(manager.GetCollisions(&wallB) == std::vector<Engine::Entity*>{&mover, &wallC});
+
+    manager.BakeStatic();
+    REQUIRE(manager.GetCollisions(&mover) == std::vector<Engine::Entity*>{&wallC, &wallB});
+
+    // Statics are found by the box they were registered with - re-register one to move it
+    wallB.MoveTo(100, 100);
+    manager.Unregister(&wallB);
+    manager.RegisterStatic(&wallB);
+    mover.MoveTo(95, 95);
+    manager.UpdateCollider(&mover);
+    REQUIRE(manager.GetCollisions(&mover) == std::vector<Engine::Entity*>{&wallB});
+}
+
+TEST_CASE("CollisionManager region queries match a linear scan with every broadphase", "[CollisionManager]") {
+    auto boxes = MakeBoxes(400, 53);
+    auto walls = MakeBoxes(100, 59);
+    auto box = [](const Box& b) { return Engine::AABB::FromRectangle(b.bounds); };
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::SpatialHash,
+                                          Engine::Broadphase::AABBTree, Engine::Broadphase::SweepAndPrune,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        for (size_t i = 0; i < boxes.size(); i++) manager.Register(boxes[i].get(), i % 2 ? 1 : 0);
+        for (auto& wall : walls) manager.RegisterStatic(wall.get());
+        manager.BakeStatic();
+
+        // Expected: dynamics in registration order, then statics, filtered by hand
+        auto expected = [&](auto&& test, Engine::CollisionLayerMask layers) {
+            std::vector<Engine::Entity*> results;
+            for (size_t i = 0; i < boxes.size(); i++) {
+                if ((Engine::CollisionManager::LayerBit(i % 2 ? 1 : 0) & layers) && test(box(*boxes[i]))) {
+                    results.push_back(boxes[i].get());
+                }
+            }
+            for (auto& wall : walls) {
+                if ((layers & 1) && test(box(*wall))) results.push_back(wall.get());
+            }
+            return results;
+        };
+
+        std::vector<Engine::Entity*> results;
+        results.reserve(boxes.size() + walls.size());
+        const Engine::Entity* const* storage = results.data();
+        std::mt19937 rng(61);
+        std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+        for (int i = 0; i < 50; i++) {
+            float x = position(rng);
+            float y = position(rng);
+
+            Engine::Rectangle<float> area(Engine::Vector2f(x, y), Engine::Vector2f(80.0f, 40.0f));
+            Engine::CollisionRectangle<float> areaCollider(&area);
+            manager.QueryRect(area, results);
+            REQUIRE(results == expected([&](const Engine::AABB& b) {
+                Engine::Rectangle<float> r(Engine::Vector2f(b.minX, b.minY), Engine::Vector2f(b.GetWidth(), b.GetHeight()));
+                return areaCollider.IsColliding(Engine::CollisionRectangle<float>(&r));
+            }, Engine::CollisionManager::AllLayers));
+
+            // Query at a box corner so the inclusive/exclusive edges get exercised
+            Engine::AABB corner = box(*boxes[i]);
+            REQUIRE(manager.QueryPoint(Engine::Vector2f(corner.minX, corner.minY), results) > 0);
+            REQUIRE(results == expected([&](const Engine::AABB& b) {
+                return corner.minX >= b.minX && corner.minX < b.maxX && corner.minY >= b.minY && corner.minY < b.maxY;
+            }, Engine::CollisionManager::AllLayers));
+
+            manager.QueryRadius(Engine::Vector2f(x, y), 50.0f, results, Engine::CollisionManager::LayerBit(1));
+            REQUIRE(results == expected([&](const Engine::AABB& b) {
+                float dx = std::max({b.minX - x, 0.0f, x - b.maxX});
+                float dy = std::max({b.minY - y, 0.0f, y - b.maxY});
+                return dx * dx + dy * dy < 2500.0f;
+            }, Engine::CollisionManager::LayerBit(1)));
+        }
+        REQUIRE(results.data() == storage); // Refilled in place, never reallocated
+    }
+}
+
+TEST_CASE("CollisionManager Raycast returns the first collider along the ray", "[CollisionManager]") {
+    Box caster(0, 0, 10, 10, {"caster"});
+    Box target(100, 0, 10, 10, {"target"});
+    Box nearer(50, -20, 5, 20, {"nearer"}); // Ends flush with y = 0, so the ray at y = 5 passes under
+    Box wall(200, -100, 10, 200, {"wall"});
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::AABBTree,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager manager;
+        manager.SetBroadphase(broadphase);
+        manager.Register(&caster);
+        manager.Register(&target, 1);
+        manager.Register(&nearer);
+        manager.RegisterStatic(&wall);
+        manager.BakeStatic();
+
+        Engine::RaycastHit hit;
+        REQUIRE(manager.Raycast(Engine::Vector2f(5.0f, 5.0f), Engine::Vector2f(400.0f, 0.0f), hit,
+                                Engine::CollisionManager::AllLayers, &caster));
+        REQUIRE(hit.entity == &target);
+        REQUIRE(hit.time == 95.0f / 400.0f);
+        REQUIRE(hit.point.GetX() == 100.0f);
+        REQUIRE(hit.normal.GetX() == -1.0f);
+
+        // Without ignoring the caster the ray starts inside it
+        REQUIRE(manager.Raycast(Engine::Vector2f(5.0f, 5.0f), Engine::Vector2f(400.0f, 0.0f), hit));
+        REQUIRE(hit.entity == &caster);
+        REQUIRE(hit.time == 0.0f);
+
+        // Layer 0 only: through the target to the static wall
+        REQUIRE(manager.Raycast(Engine::Vector2f(5.0f, 5.0f), Engine::Vector2f(400.0f, 0.0f), hit,
+                                Engine::CollisionManager::LayerBit(0), &caster));
+        REQUIRE(hit.entity == &wall);
+
+        REQUIRE_FALSE(manager.Raycast(Engine::Vector2f(5.0f, 5.0f), Engine::Vector2f(0.0f, 50.0f), hit,
+                                      Engine::CollisionManager::AllLayers, &caster));
+        REQUIRE(hit.entity == nullptr);
+    }
+}
+
+TEST_CASE("CollisionManager parallel Step matches a serial Step", "[CollisionManager]") {
+    auto boxes = MakeBoxes(1000, 67);
+    auto walls = MakeBoxes(100, 71);
+    Engine::ThreadPool pool(4);
+
+    for (Engine::Broadphase broadphase : {Engine::Broadphase::BruteForce, Engine::Broadphase::SpatialHash,
+                                          Engine::Broadphase::AABBTree, Engine::Broadphase::SweepAndPrune,
+                                          Engine::Broadphase::PackedScan}) {
+        Engine::CollisionManager serial;
+        Engine::CollisionManager parallel;
+        serial.SetBroadphase(broadphase);
+        parallel.SetBroadphase(broadphase);
+        parallel.SetThreadPool(&pool, 37); // Chunks that don't line up with anything
+        REQUIRE(parallel.GetThreadPool() == &pool);
+        for (size_t i = 0; i < boxes.size(); i++) {
+            serial.Register(boxes[i].get(), i % 3 == 0 ? 1 : 0);
+            parallel.Register(boxes[i].get(), i % 3 == 0 ? 1 : 0);
+        }
+        for (auto& wall : walls) {
+            serial.RegisterStatic(wall.get());
+            parallel.RegisterStatic(wall.get());
+        }
+        serial.BakeStatic();
+        parallel.BakeStatic();
+        serial.SetLayersInteract(1, 1, false);
+        parallel.SetLayersInteract(1, 1, false);
+
+        for (int frame = 0; frame < 3; frame++) {
+            serial.Step();
+            parallel.Step();
+            REQUIRE(parallel.GetContactCount() == serial.GetContactCount());
+            for (auto& box : boxes) {
+                REQUIRE(parallel.GetContacts(box.get()) == serial.GetContacts(box.get()));
+            }
+            for (auto& wall : walls) {
+                REQUIRE(parallel.GetContacts(wall.get()) == serial.GetContacts(wall.get()));
+            }
+            for (size_t i = 0; i < boxes.size(); i += 4) {
+                boxes[i]->MoveTo(boxes[i]->GetPosition().GetX() + 9.0f, boxes[i]->GetPosition().GetY());
+            }
+            serial.Update();
+            parallel.Update();
+        }
+    }
+}
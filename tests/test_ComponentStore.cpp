@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/ComponentStore.hpp"
+#include "engine/EntityManager.hpp"
+
+TEST_CASE("ComponentStore create and destroy", "[ComponentStore]") {
+    Engine::ComponentStore store;
+    Engine::ComponentHandle a = store.Create(Engine::Vector2f(1.0f, 2.0f));
+    Engine::ComponentHandle b = store.Create(Engine::Vector2f(3.0f, 4.0f));
+    Engine::ComponentHandle c = store.Create(Engine::Vector2f(5.0f, 6.0f));
+    REQUIRE(store.Count() == 3);
+
+    store.Destroy(a);
+    REQUIRE(store.Count() == 2);
+    REQUIRE_FALSE(store.IsValid(a));
+
+    // Swap-remove moved the last row, handles still resolve
+    REQUIRE(store.GetPosition(b).GetX() == 3.0f);
+    REQUIRE(store.GetPosition(c).GetX() == 5.0f);
+    REQUIRE(store.GetPosition(c).GetY() == 6.0f);
+
+    Engine::ComponentHandle d = store.Create(Engine::Vector2f(0.0f));
+    REQUIRE(d.index == a.index);
+    REQUIRE(d != a);
+}
+
+TEST_CASE("ComponentStore ignores stale and null handles", "[ComponentStore]") {
+    Engine::ComponentStore store;
+    Engine::ComponentHandle stale = store.Create(Engine::Vector2f(1.0f, 2.0f));
+    store.Destroy(stale);
+    Engine::ComponentHandle live = store.Create(Engine::Vector2f(3.0f, 4.0f));
+    REQUIRE(live.index == stale.index);
+
+    // The stale handle shares live's slot index but must not reach its row
+    store.SetPosition(stale, Engine::Vector2f(9.0f, 9.0f));
+    store.SetVelocity(stale, Engine::Vector2f(1.0f, 1.0f));
+    store.SetCollider(stale, Engine::Vector2f(8.0f, 8.0f));
+    store.SetRenderInfo(stale, 4, 4, Engine::Color(255, 0, 0, 255));
+    store.RemoveComponent(stale, Engine::ComponentVelocity);
+    REQUIRE(store.GetPosition(live).GetX() == 3.0f);
+    REQUIRE_FALSE(store.Has(live, Engine::ComponentVelocity));
+    REQUIRE_FALSE(store.Has(live, Engine::ComponentCollider));
+    REQUIRE_FALSE(store.Has(live, Engine::ComponentRender));
+
+    REQUIRE(store.GetPosition(stale).GetX() == 0.0f);
+    REQUIRE(store.GetOwner(stale).IsNull());
+
+    Engine::ComponentHandle null;
+    store.SetPosition(null, Engine::Vector2f(1.0f, 1.0f));
+    REQUIRE(store.GetPosition(null).GetX() == 0.0f);
+    REQUIRE(store.Count() == 1);
+}
+
+TEST_CASE("ComponentStore movement system", "[ComponentStore]") {
+    Engine::ComponentStore store;
+    Engine::ComponentHandle mover = store.Create(Engine::Vector2f(0.0f, 0.0f));
+    Engine::ComponentHandle still = store.Create(Engine::Vector2f(10.0f, 10.0f));
+    store.SetVelocity(mover, Engine::Vector2f(2.0f, -4.0f));
+
+    store.Integrate(0.5f);
+    REQUIRE(store.GetPosition(mover).GetX() == 1.0f);
+    REQUIRE(store.GetPosition(mover).GetY() == -2.0f);
+    REQUIRE(store.GetPosition(still).GetX() == 10.0f);
+
+    REQUIRE(store.Has(mover, Engine::ComponentVelocity));
+    REQUIRE_FALSE(store.Has(still, Engine::ComponentVelocity));
+
+    store.RemoveComponent(mover, Engine::ComponentVelocity);
+    store.Integrate(1.0f);
+    REQUIRE(store.GetPosition(mover).GetX() == 1.0f);
+}
+
+TEST_CASE("ComponentStore collider bounds", "[ComponentStore]") {
+    Engine::ComponentStore store;
+    Engine::ComponentHandle handle = store.Create(Engine::Vector2f(4.0f, 8.0f));
+    store.SetCollider(handle, Engine::Vector2f(16.0f, 32.0f));
+
+    Engine::Rectangle<float> bounds = store.GetColliderBounds(handle);
+    REQUIRE(bounds.GetPosition().GetX() == 4.0f);
+    REQUIRE(bounds.GetSize().GetY() == 32.0f);
+    REQUIRE(store.Has(handle, Engine::ComponentCollider));
+}
+
+TEST_CASE("EntityManager entities can own components", "[ComponentStore]") {
+    Engine::EntityManager manager;
+    Engine::Entity* entity = manager.Create<Engine::Entity>(Engine::Vector2f(1.0f, 1.0f));
+    Engine::ComponentHandle components = manager.AddComponents(entity);
+    REQUIRE(manager.GetComponents(entity) == components);
+    REQUIRE(manager.AddComponents(entity) == components);
+
+    manager.GetComponentStore().SetVelocity(components, Engine::Vector2f(10.0f, 0.0f));
+    manager.UpdateAll(0.5f);
+    REQUIRE(entity->GetPosition().GetX() == 6.0f);
+
+    // Moving the entity directly is picked up by the row instead of being overwritten
+    entity->SetPosition(Engine::Vector2f(100.0f, 1.0f));
+    manager.UpdateAll(0.5f);
+    REQUIRE(entity->GetPosition().GetX() == 105.0f);
+    REQUIRE(manager.GetComponentStore().GetPosition(components).GetX() == 105.0f);
+
+    manager.Remove(entity);
+    manager.UpdateAll(0.0f);
+    REQUIRE_FALSE(manager.GetComponentStore().IsValid(components));
+    REQUIRE(manager.GetComponentStore().Count() == 0);
+}
+
+TEST_CASE("EntityManager DrawAll draws component rows", "[ComponentStore]") {
+    Engine::Renderer renderer;
+    renderer.SetSorting(true);
+    Engine::EntityManager manager;
+    manager.InitAll(renderer);
+
+    Engine::ComponentStore& store = manager.GetComponentStore();
+    Engine::ComponentHandle drawn = store.Create(Engine::Vector2f(0.0f, 0.0f));
+    store.SetRenderInfo(drawn, 8, 8, Engine::Color::Red());
+    store.Create(Engine::Vector2f(16.0f, 0.0f)); // No render info, not drawn
+
+    manager.DrawAll();
+    REQUIRE(renderer.GetStats().submitted == 1);
+    REQUIRE(renderer.GetStats().sortedCommands == 1);
+    REQUIRE(renderer.GetRenderLayer() == 0);
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/DrawQueue.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+    SDL_Texture* FakeTexture(int id) {
+        static char storage[8];
+        return reinterpret_cast<SDL_Texture*>(&storage[id * 2]); // Even, like real addresses
+    }
+
+    Engine::DrawQueue::Command Sprite(int texture, int y = 0) {
+        Engine::DrawQueue::Command command;
+        command.texture = FakeTexture(texture);
+        command.dest = { 0, y, 16, 16 };
+        return command;
+    }
+
+    Engine::DrawQueue::Command Shape(Uint8 red) {
+        Engine::DrawQueue::Command command;
+        command.type = Engine::DrawQueue::CommandType::FilledRect;
+        command.color = { red, 0, 0, 255 };
+        return command;
+    }
+
+    // Record order of the commands (tagged through dest.x) after sorting
+    std::vector<int> SortedOrder(Engine::DrawQueue& queue) {
+        queue.Sort();
+        std::vector<int> order;
+        queue.ForEach([&order](const Engine::DrawQueue::Command& command) { order.push_back(command.dest.x); });
+        return order;
+    }
+
+    void Add(Engine::DrawQueue& queue, Engine::DrawQueue::Command command, int tag, int layer, bool ySort = false) {
+        command.dest.x = tag;
+        queue.Add(command, layer, ySort, static_cast<float>(command.dest.y + command.dest.h));
+    }
+}
+
+TEST_CASE("DrawQueue keys order layer, then y, then material, then blend", "[DrawQueue]") {
+    using Engine::DrawQueue;
+    REQUIRE(DrawQueue::MakeKey(-1, 0, 0, SDL_BLENDMODE_NONE) < DrawQueue::MakeKey(0, 0, 0, SDL_BLENDMODE_NONE));
+    REQUIRE(DrawQueue::MakeKey(0, 1000, 50, SDL_BLENDMODE_ADD) < DrawQueue::MakeKey(1, -1000, 1, SDL_BLENDMODE_NONE));
+    REQUIRE(DrawQueue::MakeKey(0, -5, 50, SDL_BLENDMODE_ADD) < DrawQueue::MakeKey(0, 3, 1, SDL_BLENDMODE_NONE));
+    REQUIRE(DrawQueue::MakeKey(0, 0, 1, SDL_BLENDMODE_ADD) < DrawQueue::MakeKey(0, 0, 2, SDL_BLENDMODE_NONE));
+    REQUIRE(DrawQueue::MakeKey(0, 0, 1, SDL_BLENDMODE_BLEND) < DrawQueue::MakeKey(0, 0, 1, SDL_BLENDMODE_ADD));
+
+    // Out-of-range values clamp instead of wrapping into a neighbouring field
+    REQUIRE(DrawQueue::MakeKey(0, 10000000, 0, SDL_BLENDMODE_NONE) < DrawQueue::MakeKey(1, 0, 0, SDL_BLENDMODE_NONE));
+    REQUIRE(DrawQueue::MakeKey(1, -10000000, 0, SDL_BLENDMODE_NONE) > DrawQueue::MakeKey(0, 0, 0, SDL_BLENDMODE_NONE));
+}
+
+TEST_CASE("DrawQueue groups textures within a layer and keeps layers in order", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    // Layer 0 alternates two textures; layer 1 is drawn first but must stay on top
+    Add(queue, Sprite(1), 10, 1);
+    Add(queue, Sprite(0), 0, 0);
+    Add(queue, Sprite(1), 1, 0);
+    Add(queue, Sprite(0), 2, 0);
+    Add(queue, Sprite(1), 3, 0);
+    Add(queue, Sprite(0), 11, 1);
+
+    REQUIRE(queue.CountTextureSwitches() == 5);
+    std::vector<int> order = SortedOrder(queue);
+    // Layer 0 by first use (texture 1 came first, in layer 1), record order kept within a texture
+    REQUIRE(order == std::vector<int>{ 1, 3, 0, 2, 10, 11 });
+    REQUIRE(queue.CountTextureSwitches() == 3);
+}
+
+TEST_CASE("DrawQueue groups shapes by draw color", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    Add(queue, Shape(10), 0, 0);
+    Add(queue, Shape(20), 1, 0);
+    Add(queue, Shape(10), 2, 0);
+    Add(queue, Sprite(0), 3, 0);
+    Add(queue, Shape(20), 4, 0);
+
+    REQUIRE(SortedOrder(queue) == std::vector<int>{ 0, 2, 1, 4, 3 });
+}
+
+TEST_CASE("DrawQueue Y-sorts by bottom edge", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    Add(queue, Sprite(0, 50), 0, 0, true);
+    Add(queue, Sprite(1, -20), 1, 0, true);
+    Add(queue, Sprite(1, 10), 2, 0, true);
+    Add(queue, Sprite(0, 10), 3, 0, true); // Same bottom as 2 - grouped by texture instead
+
+    REQUIRE(SortedOrder(queue) == std::vector<int>{ 1, 3, 2, 0 });
+}
+
+TEST_CASE("DrawQueue Y-sorting can add texture switches", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    Add(queue, Sprite(0, 10), 0, 0, true);
+    Add(queue, Sprite(0, 30), 1, 0, true);
+    Add(queue, Sprite(1, 20), 2, 0, true);
+
+    REQUIRE(queue.CountTextureSwitches() == 1);
+    REQUIRE(SortedOrder(queue) == std::vector<int>{ 0, 2, 1 });
+    REQUIRE(queue.CountTextureSwitches() == 2);
+}
+
+TEST_CASE("DrawQueue radix sort matches a stable sort", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> layer(-3, 3);
+    std::uniform_int_distribution<int> texture(0, 3);
+    std::uniform_int_distribution<int> y(-500, 500);
+
+    struct Expected { int layer; int y; int texture; int tag; };
+    std::vector<Expected> expected;
+    for (int i = 0; i < 2000; i++) {
+        int l = layer(rng);
+        int t = texture(rng);
+        int top = y(rng);
+        bool ySort = l == 0;
+        Add(queue, Sprite(t, top), i, l, ySort);
+        expected.push_back({ l, ySort ? top + 16 : 0, t, i });
+    }
+
+    // Textures are numbered by first use, so rank them the same way for the reference
+    std::vector<int> firstUse;
+    for (const Expected& e : expected) {
+        if (std::find(firstUse.begin(), firstUse.end(), e.texture) == firstUse.end()) firstUse.push_back(e.texture);
+    }
+    auto rank = [&firstUse](int texture) {
+        return std::find(firstUse.begin(), firstUse.end(), texture) - firstUse.begin();
+    };
+    std::stable_sort(expected.begin(), expected.end(), [&rank](const Expected& a, const Expected& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.y != b.y) return a.y < b.y;
+        return rank(a.texture) < rank(b.texture);
+    });
+
+    std::vector<int> order = SortedOrder(queue);
+    REQUIRE(order.size() == expected.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        REQUIRE(order[i] == expected[i].tag);
+    }
+}
+
+TEST_CASE("DrawQueue Clear forgets commands and materials", "[DrawQueue]") {
+    Engine::DrawQueue queue;
+    Add(queue, Sprite(0), 0, 0);
+    Add(queue, Sprite(1), 1, 0);
+    queue.Clear();
+    REQUIRE(queue.IsEmpty());
+
+    // Texture 1 is now first used, so it sorts first
+    Add(queue, Sprite(1), 0, 0);
+    Add(queue, Sprite(0), 1, 0);
+    Add(queue, Sprite(1), 2, 0);
+    REQUIRE(SortedOrder(queue) == std::vector<int>{ 0, 2, 1 });
+}
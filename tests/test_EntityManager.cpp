@@ -0,0 +1,685 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/EntityManager.hpp"
+#include <set>
+
+namespace {
+    class TestEntity : public Engine::Entity {
+    public:
+        int updates = 0;
+        TestEntity() = default;
+        TestEntity(std::initializer_list<std::string> tags) : Entity(Engine::Vector2f(0.0f), tags) {}
+        void Update(float deltaTime) override { (void)deltaTime; updates++; }
+    };
+}
+
+TEST_CASE("EntityManager issues handles on create", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* entity = manager.Create<TestEntity>();
+    Engine::EntityHandle handle = entity->GetHandle();
+
+    REQUIRE_FALSE(handle.IsNull());
+    REQUIRE(manager.IsValid(handle));
+    REQUIRE(manager.Get(handle) == entity);
+    REQUIRE(manager.Get<TestEntity>(handle) == entity);
+    REQUIRE(manager.Count() == 1);
+}
+
+TEST_CASE("EntityManager handles go stale after removal", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::EntityHandle handle = manager.Create<TestEntity>()->GetHandle();
+
+    manager.Remove(handle);
+    REQUIRE(manager.IsValid(handle)); // Removal is deferred to end of update
+    manager.UpdateAll(0.0f);
+
+    REQUIRE_FALSE(manager.IsValid(handle));
+    REQUIRE(manager.Get(handle) == nullptr);
+    REQUIRE(manager.Count() == 0);
+
+    SECTION("Reused slot does not resurrect old handle") {
+        Engine::EntityHandle reused = manager.Create<TestEntity>()->GetHandle();
+        REQUIRE(reused.index == handle.index);
+        REQUIRE(reused.generation != handle.generation);
+        REQUIRE(manager.Get(handle) == nullptr);
+        REQUIRE(manager.IsValid(reused));
+    }
+
+    SECTION("Removing a stale handle is a no-op") {
+        TestEntity* other = manager.Create<TestEntity>();
+        manager.Remove(handle);
+        manager.UpdateAll(0.0f);
+        REQUIRE(manager.Count() == 1);
+        REQUIRE(manager.IsValid(other->GetHandle()));
+    }
+}
+
+TEST_CASE("EntityManager removal keeps remaining entities addressable", "[EntityManager]") {
+    Engine::EntityManager manager;
+    std::vector<Engine::EntityHandle> handles;
+    for (int i = 0; i < 10; i++) {
+        handles.push_back(manager.Create<TestEntity>()->GetHandle());
+    }
+
+    manager.Remove(handles[2]);
+    manager.Remove(handles[5]);
+    manager.Remove(handles[5]); // Duplicate
+    manager.Remove(manager.Get(handles[9]));
+    manager.UpdateAll(0.0f);
+
+    REQUIRE(manager.Count() == 7);
+    for (size_t i = 0; i < handles.size(); i++) {
+        bool removed = (i == 2 || i == 5 || i == 9);
+        REQUIRE(manager.IsValid(handles[i]) == !removed);
+    }
+
+    // Survivors can still be removed by handle after compaction
+    manager.Remove(handles[8]);
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.Count() == 6);
+    REQUIRE_FALSE(manager.IsValid(handles[8]));
+}
+
+TEST_CASE("EntityManager tag lookup by handle", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* ball = manager.Create<TestEntity>(std::initializer_list<std::string>{"ball"});
+
+    REQUIRE(manager.FindHandleByTag("ball") == ball->GetHandle());
+    REQUIRE(manager.FindHandleByTag("paddle").IsNull());
+
+    manager.RemoveByTag("ball");
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.FindByTag("ball") == nullptr);
+    REQUIRE(manager.CountByTag("ball") == 0);
+}
+
+TEST_CASE("EntityManager clear invalidates handles", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::EntityHandle a = manager.Create<TestEntity>()->GetHandle();
+    Engine::EntityHandle b = manager.Create<TestEntity>()->GetHandle();
+
+    manager.Clear();
+    REQUIRE(manager.Count() == 0);
+    REQUIRE_FALSE(manager.IsValid(a));
+    REQUIRE_FALSE(manager.IsValid(b));
+
+    manager.Create<TestEntity>();
+    manager.Create<TestEntity>();
+    REQUIRE_FALSE(manager.IsValid(a));
+    REQUIRE_FALSE(manager.IsValid(b));
+}
+
+TEST_CASE("EntityManager batches mass removals", "[EntityManager]") {
+    Engine::EntityManager manager;
+    std::vector<TestEntity*> bullets;
+    for (int i = 0; i < 100; i++) {
+        bullets.push_back(manager.Create<TestEntity>(std::initializer_list<std::string>{"bullet", "projectile"}));
+        manager.Create<TestEntity>(std::initializer_list<std::string>{"enemy", "projectile"});
+    }
+
+    SECTION("RemoveByTag clears every bucket the entities were in") {
+        manager.RemoveByTag("bullet");
+        manager.RemoveByTag("bullet"); // Duplicates are dropped at queue time
+        REQUIRE(manager.IsPendingRemoval(bullets[0]->GetHandle()));
+        manager.UpdateAll(0.0f);
+
+        REQUIRE(manager.Count() == 100);
+        REQUIRE(manager.CountByTag("bullet") == 0);
+        REQUIRE(manager.CountByTag("projectile") == 100);
+        REQUIRE(manager.CountByTag("enemy") == 100);
+        for (Engine::Entity* entity : manager.FindAllByTag("projectile")) {
+            REQUIRE(entity->HasTag("enemy"));
+        }
+    }
+
+    SECTION("Partial removal keeps order of survivors") {
+        for (size_t i = 0; i < bullets.size(); i += 2) {
+            manager.Remove(bullets[i]);
+        }
+        manager.UpdateAll(0.0f);
+
+        const auto& remaining = manager.FindAllByTag("bullet");
+        REQUIRE(remaining.size() == 50);
+        for (size_t i = 0; i < remaining.size(); i++) {
+            REQUIRE(remaining[i] == bullets[i * 2 + 1]);
+        }
+    }
+}
+
+namespace {
+    // Removes a partner entity when destroyed
+    class LinkedEntity : public Engine::Entity {
+    public:
+        Engine::EntityManager* manager = nullptr;
+        Engine::EntityHandle partner;
+        ~LinkedEntity() override {
+            if (manager) manager->Remove(partner);
+        }
+    };
+}
+
+TEST_CASE("EntityManager handles removals queued by destructors", "[EntityManager]") {
+    Engine::EntityManager manager;
+    LinkedEntity* first = manager.Create<LinkedEntity>();
+    LinkedEntity* second = manager.Create<LinkedEntity>();
+    first->manager = &manager;
+    first->partner = second->GetHandle();
+    Engine::EntityHandle secondHandle = second->GetHandle();
+
+    manager.Remove(first);
+    manager.UpdateAll(0.0f);
+
+    REQUIRE(manager.Count() == 0);
+    REQUIRE_FALSE(manager.IsValid(secondHandle));
+}
+
+namespace {
+    int g_liveCounted = 0;
+
+    class CountedEntity : public Engine::Entity {
+    public:
+        int payload[4] = {0, 0, 0, 0};
+        CountedEntity() { g_liveCounted++; }
+        ~CountedEntity() override { g_liveCounted--; }
+    };
+}
+
+TEST_CASE("EntityManager arena allocation", "[EntityManager]") {
+    g_liveCounted = 0;
+    Engine::EntityManager manager;
+    manager.SetUseArena(true);
+
+    std::vector<CountedEntity*> entities;
+    for (int i = 0; i < 16; i++) {
+        entities.push_back(manager.Create<CountedEntity>());
+    }
+    REQUIRE(g_liveCounted == 16);
+
+    SECTION("Entities of one type are laid out contiguously") {
+        auto* base = reinterpret_cast<char*>(entities[0]);
+        for (size_t i = 1; i < entities.size(); i++) {
+            auto* current = reinterpret_cast<char*>(entities[i]);
+            REQUIRE(current - base == static_cast<std::ptrdiff_t>(i * sizeof(CountedEntity)));
+        }
+    }
+
+    SECTION("Removal runs destructors and reuses the block") {
+        CountedEntity* removed = entities[3];
+        manager.Remove(removed);
+        manager.UpdateAll(0.0f);
+        REQUIRE(g_liveCounted == 15);
+
+        CountedEntity* reused = manager.Create<CountedEntity>();
+        REQUIRE(reused == removed);
+        REQUIRE(g_liveCounted == 16);
+    }
+
+    SECTION("Clear destroys everything and rewinds the arena") {
+        manager.Add(std::make_unique<CountedEntity>()); // Heap-allocated alongside arena ones
+        REQUIRE(g_liveCounted == 17);
+
+        manager.Clear();
+        REQUIRE(g_liveCounted == 0);
+        REQUIRE(manager.Count() == 0);
+
+        // Memory is reused from the start of the slab
+        REQUIRE(manager.Create<CountedEntity>() == entities[0]);
+    }
+
+    manager.Clear();
+    REQUIRE(g_liveCounted == 0);
+}
+
+namespace {
+    class OtherEntity : public Engine::Entity {};
+}
+
+TEST_CASE("EntityManager typed iteration", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* a = manager.Create<TestEntity>();
+    manager.Create<OtherEntity>();
+    TestEntity* b = manager.Create<TestEntity>();
+    manager.Add(std::make_unique<TestEntity>()); // Not type-indexed
+
+    std::vector<TestEntity*> visited;
+    manager.ForEachOfType<TestEntity>([&](TestEntity* entity) { visited.push_back(entity); });
+    REQUIRE(visited == std::vector<TestEntity*>{a, b});
+    REQUIRE(manager.CountByType<TestEntity>() == 2);
+    REQUIRE(manager.CountByType<OtherEntity>() == 1);
+
+    manager.Remove(a);
+    manager.UpdateAll(0.0f);
+    visited.clear();
+    manager.ForEachOfType<TestEntity>([&](TestEntity* entity) { visited.push_back(entity); });
+    REQUIRE(visited == std::vector<TestEntity*>{b});
+
+    int count = 0;
+    manager.ForEach([&](Engine::Entity*) { count++; });
+    REQUIRE(count == 3);
+}
+
+TEST_CASE("EntityManager TagId overloads", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::TagId ball = Engine::TagRegistry::Intern("ball");
+    TestEntity* entity = manager.Create<TestEntity>(std::initializer_list<std::string>{"ball"});
+
+    REQUIRE(manager.FindByTag(ball) == entity);
+    REQUIRE(manager.FindAllByTag(ball).size() == 1);
+    REQUIRE(manager.CountByTag(ball) == 1);
+
+    int visited = 0;
+    manager.ForEachWithTag(ball, [&](Engine::Entity*) { visited++; });
+    REQUIRE(visited == 1);
+
+    manager.RemoveByTag(ball);
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.FindByTag(ball) == nullptr);
+
+    // Unknown tags are never interned by lookups
+    REQUIRE(manager.FindByTag("never_registered_tag") == nullptr);
+    REQUIRE(Engine::TagRegistry::Find("never_registered_tag") == Engine::TagRegistry::InvalidTag);
+}
+
+namespace {
+    // Spawns one child on its first update, removes itself on the second
+    class Spawner : public Engine::Entity {
+    public:
+        Engine::EntityManager* manager = nullptr;
+        int id = 0;
+        int frame = 0;
+
+        Spawner(Engine::EntityManager* manager, int id)
+            : Entity(Engine::Vector2f(0.0f), {"spawner"}), manager(manager), id(id) {
+            SetThreadSafe(true);
+        }
+
+        void Update(float deltaTime) override {
+            (void)deltaTime;
+            if (frame == 0) {
+                manager->Create<TestEntity>(std::initializer_list<std::string>{"child"})
+                    ->SetPosition(Engine::Vector2f(static_cast<float>(id)));
+            } else if (frame == 1) {
+                manager->Remove(this);
+            }
+            frame++;
+        }
+    };
+}
+
+TEST_CASE("EntityManager parallel update defers structural changes", "[EntityManager]") {
+    Engine::ThreadPool pool(4);
+    Engine::EntityManager manager;
+    manager.SetThreadPool(&pool, 8);
+
+    for (int i = 0; i < 200; i++) {
+        manager.Create<Spawner>(&manager, i);
+    }
+    TestEntity* serial = manager.Create<TestEntity>(); // Not thread-safe
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(serial->updates == 1);
+    REQUIRE(manager.CountByTag("child") == 200);
+    REQUIRE(manager.CountByType<TestEntity>() == 201);
+
+    // Children are merged in the order of the entities that spawned them
+    const auto& children = manager.FindAllByTag("child");
+    for (size_t i = 0; i < children.size(); i++) {
+        REQUIRE(children[i]->GetPosition().GetX() == static_cast<float>(i));
+        REQUIRE(manager.IsValid(children[i]->GetHandle()));
+    }
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.CountByTag("spawner") == 0);
+    REQUIRE(manager.Count() == 201);
+    REQUIRE(serial->updates == 2);
+}
+
+namespace {
+    // Exercises every kind of structural change from inside Update
+    class Mutator : public Engine::Entity {
+    public:
+        Engine::EntityManager* manager;
+        Engine::Entity* target;
+        int frame = 0;
+        Mutator(Engine::EntityManager* manager, Engine::Entity* target) : manager(manager), target(target) {}
+        void Update(float deltaTime) override {
+            (void)deltaTime;
+            if (frame == 0) {
+                for (int i = 0; i < 100; i++) {
+                    manager->Create<TestEntity>(std::initializer_list<std::string>{"spawned"});
+                }
+                Engine::Entity* doomed = manager->Create<TestEntity>(std::initializer_list<std::string>{"spawned"});
+                manager->Remove(doomed); // Not in the manager yet
+                manager->AddTag(target, "marked");
+                manager->RemoveTag(target, "enemy");
+                manager->SetRenderLayer(target, -1);
+            }
+            frame++;
+        }
+    };
+}
+
+namespace {
+    // Moves itself to another render layer from a worker thread
+    class LayerHopper : public Engine::Entity {
+    public:
+        int layer;
+        LayerHopper(int layer) : layer(layer) { SetThreadSafe(true); }
+        void Update(float deltaTime) override {
+            (void)deltaTime;
+            SetRenderLayer(layer);
+        }
+    };
+}
+
+TEST_CASE("EntityManager parallel update defers render layer moves", "[EntityManager]") {
+    Engine::ThreadPool pool(4);
+    Engine::EntityManager manager;
+    manager.SetThreadPool(&pool, 4);
+
+    std::vector<LayerHopper*> hoppers;
+    for (int i = 0; i < 200; i++) {
+        hoppers.push_back(manager.Create<LayerHopper>(i % 2 == 0 ? 10 : -10));
+    }
+
+    manager.UpdateAll(0.0f);
+    std::vector<Engine::Entity*> order;
+    manager.ForEachInDrawOrder([&order](Engine::Entity* entity) { order.push_back(entity); });
+    REQUIRE(order.size() == hoppers.size());
+
+    // Odd hoppers (layer -10) first, then even ones, each in insertion order
+    std::vector<Engine::Entity*> expected;
+    for (size_t i = 1; i < hoppers.size(); i += 2) expected.push_back(hoppers[i]);
+    for (size_t i = 0; i < hoppers.size(); i += 2) expected.push_back(hoppers[i]);
+    REQUIRE(order == expected);
+}
+
+TEST_CASE("EntityManager defers structural changes made during update", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* target = manager.Create<TestEntity>(std::initializer_list<std::string>{"enemy"});
+    manager.Create<Mutator>(&manager, target);
+    manager.DrawAll();
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.CountByTag("spawned") == 100);
+    REQUIRE(manager.Count() == 102);
+    REQUIRE(manager.CountByTag("marked") == 1);
+    REQUIRE(manager.CountByTag("enemy") == 0);
+    REQUIRE(target->HasTag("marked"));
+    REQUIRE_FALSE(target->HasTag("enemy"));
+
+    // New entities are not updated until the next pass
+    for (Engine::Entity* entity : manager.FindAllByTag("spawned")) {
+        REQUIRE(static_cast<TestEntity*>(entity)->updates == 0);
+    }
+
+    // The layer change moved the target to the front of the draw order
+    Engine::Entity* first = nullptr;
+    manager.ForEachInDrawOrder([&first](Engine::Entity* entity) {
+        if (!first) first = entity;
+    });
+    REQUIRE(first == target);
+}
+
+TEST_CASE("EntityManager plays back a recorded command buffer", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* existing = manager.Create<TestEntity>(std::initializer_list<std::string>{"a"});
+
+    Engine::EntityCommandBuffer commands;
+    TestEntity* created = commands.Create<TestEntity>();
+    commands.AddTag(created, Engine::TagRegistry::Intern("b"));
+    commands.RemoveTag(existing, Engine::TagRegistry::Intern("a"));
+    commands.AddTag(existing, Engine::TagRegistry::Intern("a")); // Re-added in the same batch
+    commands.Remove(existing);
+    REQUIRE(created->GetHandle().IsNull());
+
+    manager.Playback(commands);
+    REQUIRE(commands.IsEmpty());
+    REQUIRE(manager.IsValid(created->GetHandle()));
+    REQUIRE(manager.FindByTag("b") == created);
+    REQUIRE(manager.CountByTag("a") == 1);
+    REQUIRE(manager.IsPendingRemoval(existing->GetHandle()));
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.Count() == 1);
+    REQUIRE(manager.CountByTag("a") == 0);
+}
+
+TEST_CASE("EntityManager draw order follows render layers", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* top = manager.Create<TestEntity>();
+    top->SetRenderLayer(10);
+    TestEntity* bottom = manager.Create<TestEntity>();
+    TestEntity* middle = manager.Create<TestEntity>();
+    middle->SetRenderLayer(5);
+
+    auto drawOrder = [&manager]() {
+        std::vector<Engine::Entity*> order;
+        manager.ForEachInDrawOrder([&order](Engine::Entity* entity) { order.push_back(entity); });
+        return order;
+    };
+
+    REQUIRE(drawOrder() == std::vector<Engine::Entity*>{bottom, middle, top});
+    // Update order is untouched by layers
+    REQUIRE(manager.GetAll() == std::vector<Engine::Entity*>{top, bottom, middle});
+
+    // Changing the layer moves the entity without MarkDirty
+    top->SetRenderLayer(-1);
+    REQUIRE(drawOrder() == std::vector<Engine::Entity*>{top, bottom, middle});
+
+    // Removed entities leave the draw order, later ones keep their place within the layer
+    TestEntity* middle2 = manager.Create<TestEntity>();
+    middle2->SetRenderLayer(5);
+    manager.Remove(middle);
+    manager.UpdateAll(0.0f);
+    manager.DrawAll();
+    REQUIRE(drawOrder() == std::vector<Engine::Entity*>{top, bottom, middle2});
+    REQUIRE(manager.GetAll() == std::vector<Engine::Entity*>{top, bottom, middle2});
+}
+
+TEST_CASE("EntityManager skips sleeping entities", "[EntityManager]") {
+    Engine::EntityManager manager;
+    TestEntity* awake = manager.Create<TestEntity>();
+    TestEntity* sleeper = manager.Create<TestEntity>();
+    TestEntity* late = manager.Create<TestEntity>();
+    sleeper->Sleep();
+
+    REQUIRE(manager.GetActiveCount() == 2);
+    REQUIRE(manager.GetSleepingCount() == 1);
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(awake->updates == 1);
+    REQUIRE(sleeper->updates == 0);
+    REQUIRE(late->updates == 1);
+
+    // Waking out of insertion order still updates in insertion order
+    sleeper->Wake();
+    manager.UpdateAll(0.0f);
+    REQUIRE(sleeper->updates == 1);
+    REQUIRE(manager.GetActiveCount() == 3);
+
+    // Removing a sleeping entity keeps the counters straight
+    sleeper->Sleep();
+    manager.Remove(sleeper);
+    manager.UpdateAll(0.0f);
+    REQUIRE(manager.GetSleepingCount() == 0);
+    REQUIRE(manager.GetActiveCount() == 2);
+    REQUIRE(awake->updates == 3);
+}
+
+namespace {
+    class OrderLogger : public Engine::Entity {
+    public:
+        std::vector<int>* log;
+        int id;
+        OrderLogger(std::vector<int>* log, int id) : log(log), id(id) {}
+        void Update(float deltaTime) override { (void)deltaTime; log->push_back(id); }
+    };
+}
+
+TEST_CASE("EntityManager wake keeps update order behind a hole at the end", "[EntityManager]") {
+    Engine::EntityManager manager;
+    std::vector<int> log;
+    std::vector<OrderLogger*> entities;
+    for (int i = 0; i < 10; i++) {
+        entities.push_back(manager.Create<OrderLogger>(&log, i));
+    }
+
+    // Few enough holes that the active list isn't rebuilt on that count alone
+    entities[2]->Sleep();
+    entities[9]->Sleep(); // Leaves a hole at the end of the active list
+    entities[2]->Wake();
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(log == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+}
+
+TEST_CASE("EntityManager activation region", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::Camera camera(100.0f, 100.0f);
+    manager.SetActivationRegion(&camera, 10.0f);
+
+    TestEntity* near = manager.Create<TestEntity>();
+    near->SetPosition(Engine::Vector2f(105.0f, 50.0f)); // Inside the margin
+    TestEntity* far = manager.Create<TestEntity>();
+    far->SetPosition(Engine::Vector2f(500.0f, 50.0f));
+    near->SetAutoSleep(true);
+    far->SetAutoSleep(true);
+
+    manager.UpdateAll(0.0f);
+    REQUIRE(near->updates == 1);
+    REQUIRE(far->updates == 0);
+    REQUIRE(far->GetState() == Engine::EntityState::Dormant);
+    REQUIRE(manager.GetDormantCount() == 1);
+
+    camera.SetPosition(450.0f, 0.0f);
+    manager.UpdateAll(0.0f);
+    REQUIRE(far->updates == 1);
+    REQUIRE(near->GetState() == Engine::EntityState::Dormant);
+
+    manager.SetActivationRegion(nullptr, 0.0f);
+    REQUIRE(manager.GetDormantCount() == 0);
+}
+
+namespace {
+    class Box : public TestEntity, public Engine::ICollidable {
+    public:
+        Engine::Rectangle<float> bounds;
+        Engine::CollisionRectangle<float> collider;
+        Box(float x) : bounds(Engine::Vector2f(x, 0.0f), Engine::Vector2f(10.0f, 10.0f)), collider(&bounds) {}
+        Engine::CollisionRectangle<float>* GetCollider() override { return &collider; }
+        Engine::Entity* AsEntity() override { return this; }
+    };
+}
+
+TEST_CASE("EntityManager collision contact wakes sleeping entities", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::CollisionManager collisions;
+    Box* mover = manager.Create<Box>(0.0f);
+    Box* sleeper = manager.Create<Box>(5.0f);
+    Box* distant = manager.Create<Box>(100.0f);
+    sleeper->Sleep();
+    distant->Sleep();
+    collisions.Register(mover);
+    collisions.Register(sleeper);
+    collisions.Register(distant);
+
+    REQUIRE(collisions.GetCollisions(mover).size() == 1);
+    REQUIRE(sleeper->IsAwake());
+    REQUIRE_FALSE(distant->IsAwake());
+    REQUIRE(manager.GetSleepingCount() == 1);
+}
+
+TEST_CASE("EntityManager Step wakes entities that start touching", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::CollisionManager collisions;
+    Box* mover = manager.Create<Box>(50.0f);
+    Box* sleeper = manager.Create<Box>(5.0f);
+    Box* distant = manager.Create<Box>(100.0f);
+    sleeper->Sleep();
+    distant->Sleep();
+    collisions.Register(mover);
+    collisions.Register(sleeper);
+    collisions.Register(distant);
+
+    collisions.Step();
+    REQUIRE_FALSE(sleeper->IsAwake());
+
+    // Moving into the sleeper starts a contact, which wakes both sides
+    mover->bounds.SetPosition(Engine::Vector2f(0.0f, 0.0f));
+    collisions.Step();
+    REQUIRE(sleeper->IsAwake());
+    REQUIRE_FALSE(distant->IsAwake());
+
+    // An ongoing contact doesn't wake again
+    sleeper->Sleep();
+    collisions.Step();
+    REQUIRE_FALSE(sleeper->IsAwake());
+    REQUIRE(manager.GetSleepingCount() == 2);
+}
+
+TEST_CASE("EntityManager tag changes show up in GetTags", "[EntityManager]") {
+    Engine::EntityManager manager;
+    Engine::Entity* entity = manager.Create<TestEntity>(std::initializer_list<std::string>{"enemy"});
+
+    manager.AddTag(entity, "flying");
+    REQUIRE(entity->GetTags() == std::set<std::string>{"enemy", "flying"});
+    REQUIRE(entity->HasTag("flying"));
+
+    manager.RemoveTag(entity, "enemy");
+    REQUIRE(entity->GetTags() == std::set<std::string>{"flying"});
+    REQUIRE_FALSE(entity->HasTag("enemy"));
+    REQUIRE(manager.CountByTag("enemy") == 0);
+}
+
+namespace {
+    // Registers itself as a collider from a worker thread on its first update
+    class Joiner : public Engine::Entity, public Engine::ICollidable {
+    public:
+        Engine::Rectangle<float> bounds;
+        Engine::CollisionRectangle<float> collider;
+        size_t registeredBefore = 0;
+
+        Joiner() : bounds(Engine::Vector2f(0.0f), Engine::Vector2f(8.0f)), collider(&bounds) { SetThreadSafe(true); }
+        void Update(float deltaTime) override {
+            (void)deltaTime;
+            registeredBefore = m_collisionManager->Count();
+            m_collisionManager->Register(this);
+        }
+
+        Engine::CollisionRectangle<float>* GetCollider() override { return &collider; }
+        Engine::Entity* AsEntity() override { return this; }
+    };
+}
+
+TEST_CASE("EntityManager parallel update registers colliders in update order", "[EntityManager]") {
+    Engine::ThreadPool pool(4);
+    Engine::Renderer renderer;
+    Engine::CollisionManager collisions;
+    Engine::EntityManager manager;
+    std::vector<Engine::Entity*> joiners;
+
+    SECTION("Split across workers") {
+        manager.SetThreadPool(&pool, 3);
+        for (int i = 0; i < 200; i++) {
+            joiners.push_back(manager.Create<Joiner>());
+        }
+    }
+
+    SECTION("Small enough to run inline") {
+        manager.SetThreadPool(&pool, 1000);
+        for (int i = 0; i < 20; i++) {
+            joiners.push_back(manager.Create<Joiner>());
+        }
+    }
+
+    manager.InitAll(renderer, &collisions);
+    manager.UpdateAll(0.0f);
+
+    // Nothing was registered mid-pass, and query results follow the entities' update order
+    for (Engine::Entity* joiner : joiners) {
+        REQUIRE(static_cast<Joiner*>(joiner)->registeredBefore == 0);
+    }
+    std::vector<Engine::Entity*> found;
+    collisions.QueryRect(Engine::Rectangle<float>(Engine::Vector2f(0.0f), Engine::Vector2f(8.0f)), found);
+    REQUIRE(found == joiners);
+}
@@ -0,0 +1,331 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/EntityManager.hpp"
+#include "engine/Renderer.hpp"
+#include <vector>
+
+// Unless a test sets up a SoftwareTarget, no SDL renderer is attached, so draws that get
+// through are rejected by SDL itself - those only look at what the Renderer decided to submit.
+
+TEST_CASE("Renderer culls world-space draws outside the camera", "[Renderer]") {
+    Engine::Camera camera(320.0f, 180.0f);
+    camera.SetPosition(1000.0f, 1000.0f);
+    Engine::Renderer renderer;
+    renderer.SetCamera(&camera);
+
+    renderer.DrawFilledRect(1100.0f, 1050.0f, 16, 16);     // Inside
+    renderer.DrawRect(1310.0f, 1170.0f, 16, 16);           // Overlaps the bottom-right corner
+    renderer.DrawFilledRect(984.0f, 1000.0f, 16, 16);      // Ends exactly at the left edge
+    renderer.DrawRect(2000.0f, 1000.0f, 16, 16);           // Far right
+    renderer.DrawPoint(Engine::Vector2f(1000.0f, 999.0f)); // Just above
+    renderer.DrawLine(Engine::Vector2f(900.0f, 1050.0f), Engine::Vector2f(1500.0f, 1050.0f)); // Crosses the view
+    renderer.DrawLine(Engine::Vector2f(900.0f, 900.0f), Engine::Vector2f(1500.0f, 900.0f));   // Above it
+
+    REQUIRE(renderer.GetStats().submitted == 3);
+    REQUIRE(renderer.GetStats().culled == 4);
+}
+
+TEST_CASE("Renderer culling margin, switch and screen-space draws", "[Renderer]") {
+    Engine::Camera camera(320.0f, 180.0f);
+    Engine::Renderer renderer;
+    renderer.SetCamera(&camera);
+
+    SECTION("Margin keeps draws just outside the view") {
+        renderer.SetCullMargin(8.0f);
+        renderer.DrawFilledRect(-20.0f, 0.0f, 16, 16); // Right edge at -4
+        renderer.DrawFilledRect(-30.0f, 0.0f, 16, 16); // Right edge at -14
+        REQUIRE(renderer.GetStats().submitted == 1);
+        REQUIRE(renderer.GetStats().culled == 1);
+        REQUIRE(renderer.IsVisible(Engine::Vector2f(-20.0f, 0.0f), 16, 16));
+    }
+
+    SECTION("Culling can be switched off") {
+        renderer.SetCulling(false);
+        renderer.DrawFilledRect(-500.0f, 0.0f, 16, 16);
+        REQUIRE(renderer.GetStats().submitted == 1);
+        REQUIRE(renderer.GetStats().culled == 0);
+        REQUIRE_FALSE(renderer.IsVisible(Engine::Vector2f(-500.0f, 0.0f), 16, 16));
+    }
+
+    SECTION("Screen-space draws are never culled") {
+        renderer.DrawFilledRectScreen(-500, -500, 16, 16);
+        renderer.DrawLineScreen(-500, 0, -400, 0);
+        REQUIRE(renderer.GetStats().submitted == 2);
+        REQUIRE(renderer.GetStats().culled == 0);
+    }
+
+    SECTION("ResetStats starts a new count") {
+        renderer.DrawFilledRect(-500.0f, 0.0f, 16, 16);
+        renderer.ResetStats();
+        REQUIRE(renderer.GetStats().culled == 0);
+    }
+}
+
+TEST_CASE("Renderer without a camera culls nothing", "[Renderer]") {
+    Engine::Renderer renderer;
+    renderer.DrawFilledRect(-5000.0f, -5000.0f, 16, 16);
+    REQUIRE(renderer.GetStats().submitted == 1);
+    REQUIRE(renderer.GetStats().culled == 0);
+}
+
+TEST_CASE("Renderer bulk draws cull and count each shape", "[Renderer]") {
+    Engine::Camera camera(320.0f, 180.0f);
+    Engine::Renderer renderer;
+    renderer.SetCamera(&camera);
+
+    std::vector<Engine::Rectangle<float>> rects;
+    for (int i = 0; i < 20; i++) {
+        rects.emplace_back(Engine::Vector2f(i * 32.0f, 0.0f), Engine::Vector2f(31.0f, 31.0f));
+    }
+
+    SECTION("Rects past the right edge of the view are dropped") {
+        renderer.DrawRects(rects);
+        REQUIRE(renderer.GetStats().submitted == 10);
+        REQUIRE(renderer.GetStats().culled == 10);
+
+        camera.SetPosition(320.0f, 0.0f);
+        renderer.ResetStats();
+        renderer.DrawFilledRects(rects.data(), rects.size());
+        REQUIRE(renderer.GetStats().submitted == 10); // The tenth rect ends at 319, just left of the view
+        REQUIRE(renderer.GetStats().culled == 10);
+    }
+
+    SECTION("Points are culled one by one") {
+        std::vector<Engine::Vector2f> points = { { 10.0f, 10.0f }, { -10.0f, 10.0f }, { 319.0f, 179.0f }, { 320.0f, 0.0f } };
+        renderer.DrawPoints(points);
+        REQUIRE(renderer.GetStats().submitted == 2);
+        REQUIRE(renderer.GetStats().culled == 2);
+    }
+
+    SECTION("Line strips count segments and are culled as a whole") {
+        std::vector<Engine::Vector2f> onScreen = { { -100.0f, 10.0f }, { 100.0f, 10.0f }, { 100.0f, 500.0f } };
+        std::vector<Engine::Vector2f> offScreen = { { -100.0f, -10.0f }, { 500.0f, -10.0f } };
+        renderer.DrawLines(onScreen);
+        renderer.DrawLines(offScreen);
+        renderer.DrawLines(onScreen.data(), 1); // Not a line
+        REQUIRE(renderer.GetStats().submitted == 2);
+        REQUIRE(renderer.GetStats().culled == 1);
+    }
+}
+
+namespace {
+    // Software renderer drawing into a small surface, so recorded passes can be replayed
+    // and their results read back without a window
+    struct SoftwareTarget {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_RGBA8888);
+        SDL_Renderer* sdlRenderer = SDL_CreateSoftwareRenderer(surface);
+
+        ~SoftwareTarget() {
+            SDL_DestroyRenderer(sdlRenderer);
+            SDL_FreeSurface(surface);
+        }
+
+        Uint32 Pixel(int x, int y) const {
+            SDL_Rect rect = { x, y, 1, 1 };
+            Uint32 pixel = 0;
+            SDL_RenderReadPixels(sdlRenderer, &rect, SDL_PIXELFORMAT_RGBA8888, &pixel, sizeof(pixel));
+            return pixel;
+        }
+    };
+
+    Uint32 Rgba(const Engine::Color& color) {
+        return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+               (static_cast<Uint32>(color.b) << 8) | color.a;
+    }
+
+    class RectEntity : public Engine::Entity {
+    public:
+        void Draw() override { m_renderer->DrawFilledRectScreen(0, 0, 4, 4); }
+    };
+}
+
+TEST_CASE("Renderer sorted passes nest and submit once", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+
+    SECTION("Only the outermost EndSortedPass submits") {
+        renderer.SetSorting(true);
+        renderer.BeginSortedPass();
+        renderer.DrawFilledRectScreen(0, 0, 4, 4);
+        renderer.BeginSortedPass();
+        renderer.DrawFilledRectScreen(4, 0, 4, 4);
+        renderer.EndSortedPass();
+        REQUIRE(renderer.IsRecording());
+        REQUIRE(renderer.GetStats().sortedCommands == 0);
+
+        renderer.EndSortedPass();
+        REQUIRE_FALSE(renderer.IsRecording());
+        REQUIRE(renderer.GetStats().sortedCommands == 2);
+
+        // Unmatched End is ignored
+        renderer.EndSortedPass();
+        REQUIRE(renderer.GetStats().sortedCommands == 2);
+    }
+
+    SECTION("Without sorting a pass records nothing") {
+        renderer.BeginSortedPass();
+        REQUIRE_FALSE(renderer.IsRecording());
+        renderer.DrawFilledRectScreen(0, 0, 4, 4);
+        renderer.EndSortedPass();
+        REQUIRE(renderer.GetStats().submitted == 1);
+        REQUIRE(renderer.GetStats().sortedCommands == 0);
+    }
+
+    SECTION("Turning sorting off submits an open pass") {
+        renderer.SetSorting(true);
+        renderer.BeginSortedPass();
+        renderer.DrawFilledRectScreen(0, 0, 4, 4);
+        renderer.SetSorting(false);
+        REQUIRE_FALSE(renderer.IsRecording());
+        REQUIRE(renderer.GetStats().sortedCommands == 1);
+    }
+}
+
+TEST_CASE("Renderer sorted passes group sprites by texture", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+    renderer.SetSorting(true);
+    SDL_Texture* a = SDL_CreateTexture(target.sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+    SDL_Texture* b = SDL_CreateTexture(target.sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+
+    renderer.BeginSortedPass();
+    for (int i = 0; i < 4; i++) {
+        renderer.DrawSpriteScreen(i % 2 == 0 ? a : b, nullptr, i * 8, 0, 8, 8);
+    }
+    // Another layer keeps its own group even with the same texture
+    renderer.SetRenderLayer(1);
+    renderer.DrawSpriteScreen(a, nullptr, 0, 8, 8, 8);
+    renderer.EndSortedPass();
+
+    const Engine::RenderStats& stats = renderer.GetStats();
+    REQUIRE(stats.sortedCommands == 5);
+    REQUIRE(stats.textureSwitchesUnsorted == 4);
+    REQUIRE(stats.textureSwitchesSorted == 2);
+    REQUIRE(stats.TextureSwitchesSaved() == 2);
+
+    SDL_DestroyTexture(a);
+    SDL_DestroyTexture(b);
+}
+
+TEST_CASE("Renderer reports texture switches added by Y-sorting", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+    renderer.SetSorting(true);
+    renderer.SetLayerYSorted(0, true);
+    SDL_Texture* a = SDL_CreateTexture(target.sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+    SDL_Texture* b = SDL_CreateTexture(target.sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+
+    // Bottom edges 10, 30, 20: b lands between the two a's once sorted
+    renderer.BeginSortedPass();
+    renderer.DrawSpriteScreen(a, nullptr, 0, 2, 8, 8);
+    renderer.DrawSpriteScreen(a, nullptr, 0, 22, 8, 8);
+    renderer.DrawSpriteScreen(b, nullptr, 0, 12, 8, 8);
+    renderer.EndSortedPass();
+
+    const Engine::RenderStats& stats = renderer.GetStats();
+    REQUIRE(stats.textureSwitchesUnsorted == 1);
+    REQUIRE(stats.textureSwitchesSorted == 2);
+    REQUIRE(stats.TextureSwitchesSaved() == -1);
+
+    SDL_DestroyTexture(a);
+    SDL_DestroyTexture(b);
+}
+
+TEST_CASE("Renderer Y-sorted layers order shapes by their bottom edge", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+    renderer.SetSorting(true);
+    const Engine::Color tall = Engine::Color::Red();
+    const Engine::Color shortColor = Engine::Color::Green();
+    const Engine::Color line = Engine::Color::Blue();
+    const Engine::Color overLine = Engine::Color::Yellow();
+
+    auto drawScene = [&]() {
+        renderer.BeginSortedPass();
+        // Tall rect (bottom edge 30) recorded before a short one (bottom 15) overlapping at (5, 12)
+        renderer.SetColor(tall);
+        renderer.DrawFilledRectScreen(0, 0, 10, 30);
+        renderer.SetColor(shortColor);
+        renderer.DrawFilledRectScreen(0, 10, 10, 5);
+        // Line from (20, 0) down to (20, 28), recorded before a rect ending at y 10
+        renderer.SetColor(line);
+        renderer.DrawLineScreen(20, 0, 20, 28);
+        renderer.SetColor(overLine);
+        renderer.DrawFilledRectScreen(18, 0, 4, 10);
+        renderer.EndSortedPass();
+    };
+
+    SECTION("Y-sorted layer draws lower bottom edges later") {
+        renderer.SetLayerYSorted(0, true);
+        drawScene();
+        REQUIRE(target.Pixel(5, 12) == Rgba(tall));
+        REQUIRE(target.Pixel(20, 5) == Rgba(line)); // Lines sort by their lower end
+    }
+
+    SECTION("Layers that are not Y-sorted draw materials in first-use order") {
+        drawScene();
+        REQUIRE(target.Pixel(5, 12) == Rgba(shortColor));
+        REQUIRE(target.Pixel(20, 5) == Rgba(overLine));
+    }
+
+    SECTION("Y-sorting can be switched off again") {
+        renderer.SetLayerYSorted(0, true);
+        renderer.SetLayerYSorted(0, false);
+        REQUIRE_FALSE(renderer.IsLayerYSorted(0));
+        drawScene();
+        REQUIRE(target.Pixel(5, 12) == Rgba(shortColor));
+    }
+}
+
+TEST_CASE("Renderer restores draw color and blend mode after a sorted pass", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+    renderer.SetSorting(true);
+
+    renderer.BeginSortedPass();
+    renderer.SetColor(Engine::Color::Red());
+    renderer.DrawFilledRectScreen(0, 0, 4, 4);
+    renderer.SetColor(Engine::Color::Green());
+    renderer.SetBlendMode(SDL_BLENDMODE_BLEND);
+    renderer.DrawFilledRectScreen(4, 0, 4, 4);
+    // State the caller leaves behind - replaying the draws above must not clobber it
+    renderer.SetColor(10, 20, 30, 40);
+    renderer.SetBlendMode(SDL_BLENDMODE_ADD);
+    renderer.EndSortedPass();
+
+    REQUIRE(renderer.GetStats().sortedCommands == 2);
+    REQUIRE(target.Pixel(1, 1) == Rgba(Engine::Color::Red()));
+
+    Uint8 r = 0, g = 0, b = 0, a = 0;
+    SDL_GetRenderDrawColor(target.sdlRenderer, &r, &g, &b, &a);
+    REQUIRE(r == 10);
+    REQUIRE(g == 20);
+    REQUIRE(b == 30);
+    REQUIRE(a == 40);
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(target.sdlRenderer, &blendMode);
+    REQUIRE(blendMode == SDL_BLENDMODE_ADD);
+    REQUIRE(renderer.GetBlendMode() == SDL_BLENDMODE_ADD);
+}
+
+TEST_CASE("EntityManager DrawAll restores the previous render layer", "[Renderer]") {
+    SoftwareTarget target;
+    Engine::Renderer renderer;
+    renderer.SetSDLRenderer(target.sdlRenderer);
+    renderer.SetSorting(true);
+
+    Engine::EntityManager manager;
+    manager.Create<RectEntity>()->SetRenderLayer(3);
+    manager.Create<RectEntity>()->SetRenderLayer(-2);
+    manager.InitAll(renderer);
+
+    renderer.SetRenderLayer(7);
+    manager.DrawAll();
+    REQUIRE(renderer.GetRenderLayer() == 7);
+    REQUIRE(renderer.GetStats().sortedCommands == 2);
+    REQUIRE_FALSE(renderer.IsRecording());
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "engine/SpriteBatch.hpp"
+
+using Catch::Approx;
+
+namespace {
+    // Stands in for a real texture - the batch only compares and forwards the pointer
+    SDL_Texture* FakeTexture() {
+        static char storage;
+        return reinterpret_cast<SDL_Texture*>(&storage);
+    }
+
+    const SDL_Color White = { 255, 255, 255, 255 };
+}
+
+TEST_CASE("SpriteBatch builds two triangles per quad", "[SpriteBatch]") {
+    Engine::SpriteBatch batch;
+    batch.Begin(FakeTexture(), 64, 32);
+    REQUIRE(batch.IsEmpty());
+
+    SDL_Rect dest = { 10, 20, 16, 8 };
+    batch.AddQuad(nullptr, dest, 0.0, SDL_FLIP_NONE, White);
+    batch.AddQuad(nullptr, dest, 0.0, SDL_FLIP_NONE, White);
+
+    REQUIRE(batch.GetTexture() == FakeTexture());
+    REQUIRE(batch.QuadCount() == 2);
+    REQUIRE(batch.GetVertexCount() == 8);
+    REQUIRE(batch.GetIndexCount() == 12);
+
+    // Second quad's indices point at its own vertices
+    const int* indices = batch.GetIndices();
+    for (int i = 6; i < 12; i++) {
+        REQUIRE(indices[i] >= 4);
+        REQUIRE(indices[i] < 8);
+    }
+
+    // Top-left, top-right, bottom-right, bottom-left
+    const SDL_Vertex* vertices = batch.GetVertices();
+    REQUIRE(vertices[0].position.x == Approx(10.0f));
+    REQUIRE(vertices[0].position.y == Approx(20.0f));
+    REQUIRE(vertices[2].position.x == Approx(26.0f));
+    REQUIRE(vertices[2].position.y == Approx(28.0f));
+    REQUIRE(vertices[0].tex_coord.x == Approx(0.0f));
+    REQUIRE(vertices[2].tex_coord.x == Approx(1.0f));
+    REQUIRE(vertices[2].tex_coord.y == Approx(1.0f));
+}
+
+TEST_CASE("SpriteBatch maps source rects, flips and color", "[SpriteBatch]") {
+    Engine::SpriteBatch batch;
+    batch.Begin(FakeTexture(), 64, 32);
+    SDL_Rect src = { 16, 0, 16, 16 };
+    SDL_Rect dest = { 0, 0, 16, 16 };
+
+    SECTION("Source rect becomes texture coordinates") {
+        batch.AddQuad(&src, dest, 0.0, SDL_FLIP_NONE, White);
+        const SDL_Vertex* vertices = batch.GetVertices();
+        REQUIRE(vertices[0].tex_coord.x == Approx(0.25f));
+        REQUIRE(vertices[0].tex_coord.y == Approx(0.0f));
+        REQUIRE(vertices[2].tex_coord.x == Approx(0.5f));
+        REQUIRE(vertices[2].tex_coord.y == Approx(0.5f));
+    }
+
+    SECTION("Horizontal flip swaps left and right texture coordinates") {
+        batch.AddQuad(&src, dest, 0.0, SDL_FLIP_HORIZONTAL, White);
+        const SDL_Vertex* vertices = batch.GetVertices();
+        REQUIRE(vertices[0].tex_coord.x == Approx(0.5f));
+        REQUIRE(vertices[1].tex_coord.x == Approx(0.25f));
+        REQUIRE(vertices[0].tex_coord.y == Approx(0.0f));
+    }
+
+    SECTION("Vertical flip swaps top and bottom texture coordinates") {
+        batch.AddQuad(&src, dest, 0.0, SDL_FLIP_VERTICAL, White);
+        const SDL_Vertex* vertices = batch.GetVertices();
+        REQUIRE(vertices[0].tex_coord.y == Approx(0.5f));
+        REQUIRE(vertices[3].tex_coord.y == Approx(0.0f));
+        REQUIRE(vertices[0].tex_coord.x == Approx(0.25f));
+    }
+
+    SECTION("Color is copied to every vertex") {
+        SDL_Color tint = { 255, 0, 0, 128 };
+        batch.AddQuad(&src, dest, 0.0, SDL_FLIP_NONE, tint);
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(batch.GetVertices()[i].color.r == 255);
+            REQUIRE(batch.GetVertices()[i].color.g == 0);
+            REQUIRE(batch.GetVertices()[i].color.a == 128);
+        }
+    }
+}
+
+TEST_CASE("SpriteBatch rotates clockwise about the destination centre", "[SpriteBatch]") {
+    Engine::SpriteBatch batch;
+    batch.Begin(FakeTexture(), 16, 16);
+    SDL_Rect dest = { 0, 0, 20, 10 }; // Centre (10, 5)
+
+    batch.AddQuad(nullptr, dest, 90.0, SDL_FLIP_NONE, White);
+    const SDL_Vertex* vertices = batch.GetVertices();
+
+    // Top-left corner (-10, -5) from the centre turns a quarter clockwise (y down) to (5, -10)
+    REQUIRE(vertices[0].position.x == Approx(15.0f));
+    REQUIRE(vertices[0].position.y == Approx(-5.0f));
+    // Top-right corner (10, -5) ends up at (5, 10)
+    REQUIRE(vertices[1].position.x == Approx(15.0f));
+    REQUIRE(vertices[1].position.y == Approx(15.0f));
+}
+
+TEST_CASE("SpriteBatch Clear keeps nothing queued", "[SpriteBatch]") {
+    Engine::SpriteBatch batch;
+    batch.Begin(FakeTexture(), 16, 16);
+    batch.AddQuad(nullptr, SDL_Rect{ 0, 0, 16, 16 }, 0.0, SDL_FLIP_NONE, White);
+
+    batch.Clear();
+    REQUIRE(batch.IsEmpty());
+    REQUIRE(batch.GetTexture() == nullptr);
+    REQUIRE(batch.GetIndexCount() == 0);
+}
@@ -0,0 +1,31 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/Entity.hpp"
+#include "engine/TagRegistry.hpp"
+
+TEST_CASE("TagRegistry interning", "[TagRegistry]") {
+    Engine::TagId player = Engine::TagRegistry::Intern("player");
+    REQUIRE(player != Engine::TagRegistry::InvalidTag);
+    REQUIRE(Engine::TagRegistry::Intern("player") == player);
+    REQUIRE(Engine::TagRegistry::Find("player") == player);
+    REQUIRE(Engine::TagRegistry::GetName(player) == "player");
+    REQUIRE(Engine::TagRegistry::ToMask(Engine::TagRegistry::InvalidTag) == 0);
+}
+
+TEST_CASE("TagRegistry mask iteration", "[TagRegistry]") {
+    Engine::TagMask mask = Engine::TagRegistry::ToMask(1) | Engine::TagRegistry::ToMask(5) | Engine::TagRegistry::ToMask(63);
+    std::vector<Engine::TagId> tags;
+    Engine::TagRegistry::ForEachTag(mask, [&](Engine::TagId tag) { tags.push_back(tag); });
+    REQUIRE(tags == std::vector<Engine::TagId>{1, 5, 63});
+}
+
+TEST_CASE("Entity tag membership", "[TagRegistry]") {
+    Engine::Entity entity(Engine::Vector2f(0.0f), {"grid", "background"});
+    Engine::TagId grid = Engine::TagRegistry::Find("grid");
+    Engine::TagId background = Engine::TagRegistry::Find("background");
+
+    REQUIRE(entity.HasTag(grid));
+    REQUIRE(entity.HasTag("background"));
+    REQUIRE_FALSE(entity.HasTag("player"));
+    REQUIRE(entity.HasAllTags(Engine::TagRegistry::ToMask(grid) | Engine::TagRegistry::ToMask(background)));
+    REQUIRE(entity.GetTags().size() == 2);
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/ThreadPool.hpp"
+#include <atomic>
+#include <vector>
+
+TEST_CASE("ThreadPool covers every index once", "[ThreadPool]") {
+    Engine::ThreadPool pool(4);
+    REQUIRE(pool.GetThreadCount() == 4);
+
+    std::vector<std::atomic<int>> hits(1000);
+    std::atomic<bool> badWorker{false};
+    pool.ParallelFor(hits.size(), 16, [&](size_t begin, size_t end, size_t worker) {
+        if (worker >= 4 || Engine::ThreadPool::CurrentWorkerIndex() != static_cast<int>(worker)) {
+            badWorker = true;
+        }
+        for (size_t i = begin; i < end; i++) {
+            hits[i]++;
+        }
+    });
+
+    REQUIRE_FALSE(badWorker);
+    for (auto& hit : hits) {
+        REQUIRE(hit == 1);
+    }
+    REQUIRE(Engine::ThreadPool::CurrentWorkerIndex() == -1);
+}
+
+TEST_CASE("ThreadPool runs repeated and nested jobs", "[ThreadPool]") {
+    Engine::ThreadPool pool(3);
+    std::atomic<int> total{0};
+    for (int run = 0; run < 50; run++) {
+        pool.ParallelFor(100, 8, [&](size_t begin, size_t end, size_t) {
+            // Nested calls run inline on the calling worker
+            pool.ParallelFor(end - begin, 1, [&](size_t b, size_t e, size_t) {
+                total += static_cast<int>(e - b);
+            });
+        });
+    }
+    REQUIRE(total == 5000);
+}
+
+TEST_CASE("ThreadPool with a single thread runs inline", "[ThreadPool]") {
+    Engine::ThreadPool pool(1);
+    size_t covered = 0;
+    pool.ParallelFor(10, 2, [&](size_t begin, size_t end, size_t worker) {
+        REQUIRE(worker == 0);
+        covered += end - begin;
+    });
+    REQUIRE(covered == 10);
+}
+
+TEST_CASE("ThreadPool inline jobs run as worker 0", "[ThreadPool]") {
+    Engine::ThreadPool pool(4);
+    int inlineWorker = -1;
+    pool.ParallelFor(4, 16, [&](size_t, size_t, size_t) {
+        inlineWorker = Engine::ThreadPool::CurrentWorkerIndex();
+    });
+    REQUIRE(inlineWorker == 0);
+    REQUIRE(Engine::ThreadPool::CurrentWorkerIndex() == -1);
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/TileCollisionMap.hpp"
+#include <utility>
+#include <vector>
+
+namespace {
+    Engine::Rectangle<float> Box(float x, float y, float w, float h) {
+        return Engine::Rectangle<float>(Engine::Vector2f(x, y), Engine::Vector2f(w, h));
+    }
+}
+
+TEST_CASE("TileCollisionMap covers the world", "[TileCollisionMap]") {
+    Engine::TileCollisionMap map(Engine::GameMeta(640, 360), 32.0f);
+    REQUIRE(map.GetColumns() == 20);
+    REQUIRE(map.GetRows() == 12); // 360 / 32 = 11.25, rounded up to a whole row
+    REQUIRE(map.GetTileSize() == 32.0f);
+
+    map.SetTile(3, 4, 7);
+    REQUIRE(map.GetTile(3, 4) == 7);
+    REQUIRE(map.IsSolid(3, 4));
+    REQUIRE_FALSE(map.IsSolid(4, 4));
+    REQUIRE(map.IsSolidAt(Engine::Vector2f(96.0f, 128.0f)));
+    REQUIRE_FALSE(map.IsSolidAt(Engine::Vector2f(95.9f, 128.0f)));
+
+    // Outside the map is empty unless asked otherwise; writes there are ignored
+    map.SetTile(-1, 0, 1);
+    REQUIRE_FALSE(map.IsSolid(-1, 0));
+    map.SetOutsideTile(1);
+    REQUIRE(map.IsSolid(-1, 0));
+    REQUIRE(map.IsSolid(20, 0));
+}
+
+TEST_CASE("TileCollisionMap overlap uses the strict rectangle test", "[TileCollisionMap]") {
+    Engine::TileCollisionMap map(10, 10, 16.0f);
+    for (int column = 0; column < 10; column++) {
+        map.SetTile(column, 5, 1); // Floor from y = 80 to 96
+    }
+
+    REQUIRE_FALSE(map.Overlaps(Box(20.0f, 64.0f, 10.0f, 16.0f))); // Resting exactly on the floor
+    REQUIRE(map.Overlaps(Box(20.0f, 64.5f, 10.0f, 16.0f)));
+    REQUIRE_FALSE(map.Overlaps(Box(20.0f, 96.0f, 10.0f, 10.0f))); // Just below it
+
+    std::vector<std::pair<int, int>> tiles;
+    map.ForEachOverlappingTile(Box(10.0f, 70.0f, 30.0f, 20.0f), [&tiles](int column, int row, uint8_t) {
+        tiles.emplace_back(column, row);
+        return true;
+    });
+    REQUIRE(tiles == std::vector<std::pair<int, int>>{{0, 5}, {1, 5}, {2, 5}});
+}
+
+TEST_CASE("TileCollisionMap sweep stops fast movers at the first solid tile", "[TileCollisionMap]") {
+    Engine::TileCollisionMap map(Engine::GameMeta(320, 320), 16.0f);
+    for (int row = 0; row < 20; row++) {
+        map.SetTile(10, row, 2); // One-tile wall at x = 160..176
+    }
+    for (int column = 0; column < 20; column++) {
+        map.SetTile(column, 15, 1); // Floor at y = 240
+    }
+
+    // Far enough in one step that the end position is past the wall
+    Engine::TileHit hit;
+    REQUIRE(map.Sweep(Box(0.0f, 100.0f, 8.0f, 8.0f), Engine::Vector2f(300.0f, 0.0f), hit));
+    REQUIRE(hit.column == 10);
+    REQUIRE(hit.tile == 2);
+    REQUIRE(hit.time == 152.0f / 300.0f);
+    REQUIRE(hit.normal.GetX() == -1.0f);
+    REQUIRE_FALSE(map.Overlaps(Box(300.0f, 100.0f, 8.0f, 8.0f)));
+
+    // Falling onto the floor
+    REQUIRE(map.Sweep(Box(20.0f, 200.0f, 8.0f, 8.0f), Engine::Vector2f(0.0f, 100.0f), hit));
+    REQUIRE(hit.row == 15);
+    REQUIRE(hit.time == 32.0f / 100.0f);
+    REQUIRE(hit.normal.GetY() == -1.0f);
+
+    // Sliding along the floor's top isn't a hit; stopping short isn't either
+    REQUIRE_FALSE(map.Sweep(Box(20.0f, 232.0f, 8.0f, 8.0f), Engine::Vector2f(100.0f, 0.0f), hit));
+    REQUIRE_FALSE(map.Sweep(Box(0.0f, 100.0f, 8.0f, 8.0f), Engine::Vector2f(100.0f, 0.0f), hit));
+    REQUIRE(hit.column == -1);
+
+    // Already inside a tile
+    REQUIRE(map.Sweep(Box(162.0f, 100.0f, 8.0f, 8.0f), Engine::Vector2f(10.0f, 0.0f), hit));
+    REQUIRE(hit.time == 0.0f);
+}
+
+TEST_CASE("TileCollisionMap clamps huge and far-off boxes to the map", "[TileCollisionMap]") {
+    Engine::TileCollisionMap map(4, 4, 16.0f);
+    map.SetTile(2, 1, 3);
+    const float huge = 1e30f;
+
+    SECTION("Empty outside visits only the map") {
+        int visited = 0;
+        map.ForEachOverlappingTile(Box(-huge, -huge, 2.0f * huge, 2.0f * huge), [&visited](int column, int row, uint8_t) {
+            REQUIRE(column == 2);
+            REQUIRE(row == 1);
+            visited++;
+            return true;
+        });
+        REQUIRE(visited == 1);
+        REQUIRE_FALSE(map.Overlaps(Box(huge, huge, 16.0f, 16.0f)));
+        REQUIRE_FALSE(map.Overlaps(Box(-huge, 0.0f, 16.0f, 16.0f)));
+
+        Engine::TileHit hit;
+        // Long enough to cross a million rows, but only the map's are visited
+        REQUIRE(map.Sweep(Box(40.0f, -1e7f, 4.0f, 4.0f), Engine::Vector2f(0.0f, 2e7f), hit));
+        REQUIRE(hit.column == 2);
+        REQUIRE(hit.row == 1);
+        REQUIRE_FALSE(map.Sweep(Box(huge, huge, 4.0f, 4.0f), Engine::Vector2f(huge, 0.0f), hit));
+    }
+
+    SECTION("Solid outside stops one cell past the edge") {
+        map.SetOutsideTile(1);
+        std::vector<std::pair<int, int>> tiles;
+        map.ForEachOverlappingTile(Box(70.0f, 0.0f, huge, 10.0f), [&tiles](int column, int row, uint8_t) {
+            tiles.emplace_back(column, row);
+            return true;
+        });
+        REQUIRE(tiles == std::vector<std::pair<int, int>>{{4, 0}});
+        REQUIRE(map.Overlaps(Box(-huge, -huge, 16.0f, 16.0f)));
+    }
+}